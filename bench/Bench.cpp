@@ -0,0 +1,297 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+import std;
+import vireo;
+
+// Micro-benchmarks of the RHI hot paths, results are written in JSON for trend tracking.
+// Usage : vireo_bench [--backend vulkan|directx|null] [--iterations N] [--output file.json]
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        vireo::Backend backend{vireo::Backend::VULKAN};
+        uint32_t       iterations{1000};
+        std::string    output{};
+    };
+
+    // One benchmark result : a throughput or latency percentiles
+    struct Result {
+        std::string name;
+        std::string unit;
+        double      value{0.0};
+        // Latency percentiles, empty for throughputs
+        std::vector<std::pair<std::string, double>> percentiles{};
+    };
+
+    double seconds(const Clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    double microseconds(const Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    Result latencies(const std::string& name, std::vector<double> samples) {
+        std::ranges::sort(samples);
+        const auto percentile = [&](const double q) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(q * samples.size()))];
+        };
+        return {
+            name,
+            "us",
+            std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size(),
+            {
+                {"p50", percentile(0.50)},
+                {"p90", percentile(0.90)},
+                {"p99", percentile(0.99)},
+                {"max", samples.back()},
+            }
+        };
+    }
+
+    // Commands recorded per second, with the commands which do not need a pipeline
+    Result benchRecord(const vireo::Vireo& vireo, const Options& options) {
+        constexpr auto COMMANDS_PER_GROUP = 8;
+        constexpr auto GROUPS_PER_LIST = 256;
+        const auto allocator = vireo.createCommandAllocator(vireo::CommandType::GRAPHIC);
+        const auto cmdList = allocator->createCommandList();
+        const auto source = vireo.createBuffer(vireo::BufferType::BUFFER_UPLOAD, 1024);
+        const auto destination = vireo.createBuffer(vireo::BufferType::DEVICE_STORAGE, 1024);
+        const auto vertexBuffer = vireo.createBuffer(vireo::BufferType::VERTEX, 1024);
+        const auto indexBuffer = vireo.createBuffer(vireo::BufferType::INDEX, 1024);
+        const auto pushConstantsDesc = vireo::PushConstantsDesc{ .size = 16 };
+        const auto resources = vireo.createPipelineResources({}, pushConstantsDesc);
+        const auto pushConstantsData = std::array<float, 4>{};
+        const auto viewport = vireo::Viewport{0.0f, 0.0f, 1920.0f, 1080.0f};
+        const auto scissors = vireo::Rect{1920, 1080};
+
+        auto elapsed = Clock::duration::zero();
+        for (auto i = 0u; i < options.iterations; i++) {
+            allocator->reset();
+            const auto start = Clock::now();
+            cmdList->begin();
+            for (auto group = 0; group < GROUPS_PER_LIST; group++) {
+                cmdList->copy(source, destination);
+                cmdList->barrier(*destination, vireo::ResourceState::COPY_DST, vireo::ResourceState::SHADER_READ);
+                cmdList->setViewport(viewport);
+                cmdList->setScissors(scissors);
+                cmdList->bindVertexBuffer(vertexBuffer);
+                cmdList->bindIndexBuffer(indexBuffer);
+                cmdList->pushConstants(resources, pushConstantsDesc, pushConstantsData.data());
+                cmdList->barrier(*destination, vireo::ResourceState::SHADER_READ, vireo::ResourceState::COPY_DST);
+            }
+            cmdList->end();
+            elapsed += Clock::now() - start;
+        }
+        const auto commands = static_cast<double>(options.iterations) * GROUPS_PER_LIST * COMMANDS_PER_GROUP;
+        return {"record_commands", "commands/s", commands / seconds(elapsed)};
+    }
+
+    // Submissions of an empty command list per second, waiting for each one with a fence
+    Result benchSubmit(const vireo::Vireo& vireo, const Options& options) {
+        const auto queue = vireo.createSubmitQueue(vireo::CommandType::GRAPHIC);
+        const auto allocator = vireo.createCommandAllocator(vireo::CommandType::GRAPHIC);
+        const auto cmdList = allocator->createCommandList();
+        const auto fence = vireo.createFence();
+        cmdList->begin();
+        cmdList->end();
+        const auto cmdLists = std::vector<std::shared_ptr<const vireo::CommandList>>{cmdList};
+
+        const auto start = Clock::now();
+        for (auto i = 0u; i < options.iterations; i++) {
+            queue->submit(fence, cmdLists);
+            fence->wait();
+            fence->reset();
+        }
+        const auto elapsed = Clock::now() - start;
+        queue->waitIdle();
+        return {"submit", "submits/s", options.iterations / seconds(elapsed)};
+    }
+
+    // Descriptor writes per second, one by one then in batches
+    std::vector<Result> benchDescriptorUpdate(const vireo::Vireo& vireo, const Options& options) {
+        constexpr auto BINDINGS = 8;
+        const auto layout = vireo.createDescriptorLayout();
+        for (auto binding = 0; binding < BINDINGS; binding++) {
+            layout->add(binding, vireo::DescriptorType::UNIFORM);
+        }
+        layout->build();
+        const auto set = vireo.createDescriptorSet(layout);
+        const auto buffer = vireo.createBuffer(vireo::BufferType::UNIFORM, 256);
+        auto writes = std::vector<vireo::DescriptorWrite>{};
+        for (auto binding = 0; binding < BINDINGS; binding++) {
+            writes.push_back({static_cast<vireo::DescriptorIndex>(binding), buffer});
+        }
+
+        auto start = Clock::now();
+        for (auto i = 0u; i < options.iterations; i++) {
+            for (auto binding = 0; binding < BINDINGS; binding++) {
+                set->update(binding, buffer);
+            }
+        }
+        const auto single = Clock::now() - start;
+
+        start = Clock::now();
+        for (auto i = 0u; i < options.iterations; i++) {
+            set->update(writes);
+        }
+        const auto batched = Clock::now() - start;
+
+        // Dynamic uniform sets keep the written buffer for the dynamic offsets of bindDescriptor()
+        const auto dynamicLayout = vireo.createDynamicUniformDescriptorLayout();
+        const auto dynamicSet = vireo.createDescriptorSet(dynamicLayout);
+        const auto dynamicBuffer = vireo.createBuffer(vireo::BufferType::UNIFORM, 256, 16);
+        const auto dynamicWrites = std::vector<vireo::DescriptorWrite>{{0, dynamicBuffer}};
+        start = Clock::now();
+        for (auto i = 0u; i < options.iterations; i++) {
+            dynamicSet->update(dynamicWrites);
+        }
+        const auto dynamic = Clock::now() - start;
+
+        const auto updates = static_cast<double>(options.iterations) * BINDINGS;
+        return {
+            {"descriptor_update", "writes/s", updates / seconds(single)},
+            {"descriptor_update_batch", "writes/s", updates / seconds(batched)},
+            {"descriptor_update_batch_dynamic", "writes/s", options.iterations / seconds(dynamic)},
+        };
+    }
+
+    // Bytes written per second in a mapped uniform buffer
+    Result benchBufferWrite(const vireo::Vireo& vireo, const Options& options) {
+        constexpr auto SIZE = size_t{64 * 1024};
+        const auto buffer = vireo.createBuffer(vireo::BufferType::UNIFORM, SIZE);
+        const auto data = std::vector<std::byte>(SIZE);
+        buffer->map();
+        const auto start = Clock::now();
+        for (auto i = 0u; i < options.iterations; i++) {
+            buffer->write(data.data(), SIZE);
+        }
+        const auto elapsed = Clock::now() - start;
+        buffer->unmap();
+        return {"buffer_write", "bytes/s", static_cast<double>(options.iterations) * SIZE / seconds(elapsed)};
+    }
+
+    // Creation and destruction latencies of buffers and images
+    std::vector<Result> benchCreation(const vireo::Vireo& vireo, const Options& options) {
+        auto bufferSamples = std::vector<double>{};
+        auto imageSamples = std::vector<double>{};
+        bufferSamples.reserve(options.iterations);
+        imageSamples.reserve(options.iterations);
+        for (auto i = 0u; i < options.iterations; i++) {
+            auto start = Clock::now();
+            {
+                const auto buffer = vireo.createBuffer(vireo::BufferType::DEVICE_STORAGE, 64 * 1024);
+            }
+            bufferSamples.push_back(microseconds(Clock::now() - start));
+            start = Clock::now();
+            {
+                const auto image = vireo.createImage(vireo::ImageFormat::R8G8B8A8_UNORM, 256, 256);
+            }
+            imageSamples.push_back(microseconds(Clock::now() - start));
+        }
+        return {
+            latencies("create_buffer", std::move(bufferSamples)),
+            latencies("create_image", std::move(imageSamples)),
+        };
+    }
+
+    std::string escape(const std::string& text) {
+        auto escaped = std::string{};
+        for (const auto c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            if (static_cast<unsigned char>(c) >= 0x20) {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    std::string toJson(const vireo::Vireo& vireo, const Options& options, const std::vector<Result>& results) {
+        auto json = std::string{"{\n"};
+        json += std::format("  \"backend\": \"{}\",\n",
+            options.backend == vireo::Backend::VULKAN ? "vulkan" :
+            options.backend == vireo::Backend::DIRECTX ? "directx" :
+            "null");
+        json += std::format("  \"device\": \"{}\",\n", escape(vireo.getPhysicalDevice()->getDescription().name));
+        json += std::format("  \"iterations\": {},\n", options.iterations);
+        json += "  \"results\": [\n";
+        for (int i = 0; i < results.size(); i++) {
+            const auto& result = results[i];
+            json += std::format("    {{ \"name\": \"{}\", \"unit\": \"{}\", \"value\": {:.3f}",
+                result.name, result.unit, result.value);
+            for (const auto& [percentile, value] : result.percentiles) {
+                json += std::format(", \"{}\": {:.3f}", percentile, value);
+            }
+            json += i + 1 < results.size() ? " },\n" : " }\n";
+        }
+        json += "  ]\n}\n";
+        return json;
+    }
+
+    Options parseOptions(const int argc, char** argv) {
+        auto options = Options{};
+        for (int i = 1; i < argc; i++) {
+            const auto arg = std::string_view{argv[i]};
+            if (i + 1 >= argc) {
+                throw vireo::Exception("Missing value for ", arg);
+            }
+            const auto value = std::string_view{argv[++i]};
+            if (arg == "--backend") {
+                options.backend =
+                    value == "vulkan" ? vireo::Backend::VULKAN :
+                    value == "directx" ? vireo::Backend::DIRECTX :
+                    value == "null" ? vireo::Backend::NULL_RECORDER :
+                    throw vireo::Exception("Unknown backend ", value);
+            } else if (arg == "--iterations") {
+                options.iterations = static_cast<uint32_t>(std::stoul(std::string{value}));
+            } else if (arg == "--output") {
+                options.output = value;
+            } else {
+                throw vireo::Exception("Unknown option ", arg);
+            }
+        }
+        if (options.iterations == 0) {
+            throw vireo::Exception("The number of iterations must be greater than 0");
+        }
+        return options;
+    }
+
+}
+
+int main(const int argc, char** argv) {
+    try {
+        const auto options = parseOptions(argc, argv);
+        // No window : runs on GPU-less machines with a software Vulkan driver like lavapipe
+        const auto vireo = vireo::Vireo::create({ .backend = options.backend, .headless = true });
+
+        auto results = std::vector<Result>{};
+        results.push_back(benchRecord(*vireo, options));
+        results.push_back(benchSubmit(*vireo, options));
+        std::ranges::move(benchDescriptorUpdate(*vireo, options), std::back_inserter(results));
+        results.push_back(benchBufferWrite(*vireo, options));
+        std::ranges::move(benchCreation(*vireo, options), std::back_inserter(results));
+        vireo->waitIdle();
+
+        const auto json = toJson(*vireo, options, results);
+        if (options.output.empty()) {
+            std::print("{}", json);
+        } else {
+            auto file = std::ofstream{options.output};
+            if (!file) {
+                throw vireo::Exception("Cannot write ", options.output);
+            }
+            file << json;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::println(std::cerr, "vireo_bench : {}", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,113 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.bindless;
+
+namespace vireo {
+
+    BindlessTable::BindlessTable(
+        const std::shared_ptr<DescriptorSet>& descriptorSet,
+        const DescriptorIndex binding,
+        const uint32_t capacity,
+        const uint32_t framesInFlight) :
+        descriptorSet{descriptorSet},
+        binding{binding},
+        capacity{capacity},
+        framesInFlight{framesInFlight} {
+        assert(descriptorSet != nullptr);
+        assert(descriptorSet->getLayout()->isBindless());
+        assert(capacity > 0);
+        const auto type = descriptorSet->getLayout()->getType(binding);
+        if (!type) {
+            throw Exception("BindlessTable : binding ", binding, " not found in the descriptor layout");
+        }
+        this->type = *type;
+    }
+
+    void BindlessTable::checkType(const Resource& resource) const {
+        const auto valid = std::visit([&]<typename T>(const std::shared_ptr<T>& object) {
+            assert(object != nullptr);
+            if constexpr (std::is_same_v<T, const Buffer>) {
+                return type == DescriptorType::UNIFORM ||
+                       type == DescriptorType::UNIFORM_DYNAMIC ||
+                       type == DescriptorType::STORAGE ||
+                       type == DescriptorType::DEVICE_STORAGE ||
+                       type == DescriptorType::READWRITE_STORAGE;
+            } else if constexpr (std::is_same_v<T, const Image>) {
+                return type == DescriptorType::SAMPLED_IMAGE || type == DescriptorType::READWRITE_IMAGE;
+            } else {
+                return type == DescriptorType::SAMPLER;
+            }
+        }, resource);
+        if (!valid) {
+            throw Exception("BindlessTable : resource type does not match the descriptor type of binding ", binding);
+        }
+    }
+
+    BindlessTable::Handle BindlessTable::add(const Resource& resource) {
+        checkType(resource);
+        auto handle = INVALID_HANDLE;
+        if (!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        } else if (resources.size() < capacity) {
+            handle = static_cast<Handle>(resources.size());
+            resources.emplace_back();
+            used.push_back(false);
+        } else {
+            throw Exception("BindlessTable : no free descriptor, the table is full");
+        }
+        resources[handle] = resource;
+        used[handle] = true;
+        count += 1;
+        pendingWrites.push_back({ binding, resource, handle });
+        return handle;
+    }
+
+    void BindlessTable::update(const Handle handle, const Resource& resource) {
+        assert(handle < resources.size() && used[handle]);
+        checkType(resource);
+        released.push_back({ frame, resources[handle], INVALID_HANDLE });
+        resources[handle] = resource;
+        pendingWrites.push_back({ binding, resource, handle });
+    }
+
+    void BindlessTable::remove(const Handle handle) {
+        assert(handle < resources.size() && used[handle]);
+        // The descriptor is not cleared : the slot keeps a valid resource until it is reused
+        released.push_back({ frame, resources[handle], handle });
+        used[handle] = false;
+        count -= 1;
+    }
+
+    void BindlessTable::flush() {
+        if (pendingWrites.empty()) { return; }
+        descriptorSet->update(pendingWrites);
+        pendingWrites.clear();
+    }
+
+    void BindlessTable::nextFrame() {
+        flush();
+        frame += 1;
+        // The frames recorded before `frame - framesInFlight` have completed
+        while (!released.empty() && released.front().frame + framesInFlight <= frame) {
+            const auto& front = released.front();
+            if (front.handle != INVALID_HANDLE) {
+                resources[front.handle] = {};
+                freeHandles.push_back(front.handle);
+            }
+            released.pop_front();
+        }
+    }
+
+    const BindlessTable::Resource& BindlessTable::get(const Handle handle) const {
+        assert(handle < resources.size() && used[handle]);
+        return resources[handle];
+    }
+
+}
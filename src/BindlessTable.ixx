@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.bindless;
+
+import std;
+import vireo;
+
+export namespace vireo {
+
+    /**
+     * Registry of the resources of the unbounded array of a bindless descriptor set.
+     * Each registered buffer, image or sampler gets a stable handle : the index of its descriptor in the array, given
+     * to the shaders to access it. Only the changed slots are written in the descriptor set, with one batched update
+     * per flush(). Released slots are reused only when the frames in flight which may reference them have completed.
+     *
+     * @warning Not thread-safe.
+     *
+     * Manual page : \ref manual_040_05_bindless_table
+     */
+    class BindlessTable {
+    public:
+        /**
+         * Index of a resource in the descriptors array
+         */
+        using Handle = uint32_t;
+
+        /**
+         * Buffer, image or sampler registered in the table
+         */
+        using Resource = decltype(DescriptorWrite::resource);
+
+        //! Handle never returned by add()
+        static constexpr Handle INVALID_HANDLE{std::numeric_limits<Handle>::max()};
+
+        /**
+         * Creates a table over the array binding of a bindless descriptor set
+         * @param descriptorSet Descriptor set created from a bindless layout
+         * @param binding Binding index of the descriptors array
+         * @param capacity Number of descriptors of the array
+         * @param framesInFlight Number of frames the GPU can process while the CPU records the next one
+         * Throws an Exception if the binding is not in the layout of the descriptor set.
+         */
+        BindlessTable(
+            const std::shared_ptr<DescriptorSet>& descriptorSet,
+            DescriptorIndex binding,
+            uint32_t capacity,
+            uint32_t framesInFlight);
+
+        /**
+         * Registers a resource and queues the write of its descriptor. Throws an Exception if the table is full or if
+         * the resource does not match the descriptor type of the binding.
+         * @return The handle of the resource, valid until remove()
+         */
+        Handle add(const Resource& resource);
+
+        /**
+         * Replaces the resource of a handle, for example when a streamed texture is loaded.
+         * The previous resource is kept alive until the frames in flight have completed.
+         * Throws an Exception if the resource does not match the descriptor type of the binding.
+         */
+        void update(Handle handle, const Resource& resource);
+
+        /**
+         * Releases a handle. The resource is kept alive and the slot is not reused until the frames in flight have
+         * completed.
+         */
+        void remove(Handle handle);
+
+        /**
+         * Writes the descriptors changed since the last flush with one DescriptorSet::update() call.
+         * Must be called before recording commands which use the new handles.
+         */
+        void flush();
+
+        /**
+         * Starts a new frame : flushes the changes and recycles the slots released `framesInFlight` frames ago.
+         * Call once per frame, after waiting for the fence of the frame.
+         */
+        void nextFrame();
+
+        /**
+         * Returns the resource registered with a handle
+         */
+        const Resource& get(Handle handle) const;
+
+        /**
+         * Returns the number of registered resources
+         */
+        auto getCount() const { return count; }
+
+        /**
+         * Returns the number of descriptors of the array
+         */
+        auto getCapacity() const { return capacity; }
+
+        /**
+         * Returns the bindless descriptor set
+         */
+        const auto& getDescriptorSet() const { return descriptorSet; }
+
+    private:
+        // Resource or slot released during a frame
+        struct Released {
+            uint64_t frame;
+            Resource resource;
+            // INVALID_HANDLE if only the resource was replaced
+            Handle   handle;
+        };
+
+        const std::shared_ptr<DescriptorSet> descriptorSet;
+        const DescriptorIndex                binding;
+        // Descriptor type of the binding, checked against the registered resources
+        DescriptorType                       type;
+        const uint32_t                       capacity;
+        const uint32_t                       framesInFlight;
+        uint32_t                             count{0};
+        uint64_t                             frame{0};
+        // Resources indexed by handle, grows up to the capacity
+        std::vector<Resource>                resources;
+        std::vector<bool>                    used;
+        std::vector<Handle>                  freeHandles;
+        std::deque<Released>                 released;
+        std::vector<DescriptorWrite>         pendingWrites;
+
+        void checkType(const Resource& resource) const;
+    };
+
+}
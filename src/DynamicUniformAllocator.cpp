@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.uniforms;
+
+namespace vireo {
+
+    DynamicUniformAllocator::DynamicUniformAllocator(
+        const Vireo& vireo,
+        const size_t size,
+        const uint32_t count,
+        const uint32_t framesInFlight,
+        const std::string& name) :
+        count{count},
+        framesInFlight{framesInFlight},
+        buffer{vireo.createBuffer(BufferType::UNIFORM, size, count * framesInFlight, name)} {
+        assert(count > 0);
+        assert(framesInFlight > 0);
+        // The largest dynamic offset must fit in the 32 bits offset of bindDescriptor()
+        if (buffer->getSize() > std::numeric_limits<uint32_t>::max()) {
+            throw Exception("DynamicUniformAllocator : buffer too large for 32 bits dynamic offsets");
+        }
+        buffer->map();
+    }
+
+    DynamicUniformAllocator::~DynamicUniformAllocator() {
+        buffer->unmap();
+    }
+
+    void DynamicUniformAllocator::beginFrame(const uint32_t frameIndex) {
+        first = (frameIndex % framesInFlight) * count;
+        head = 0;
+    }
+
+    DynamicUniformAllocator::Allocation DynamicUniformAllocator::allocate() {
+        if (head >= count) {
+            throw Exception("DynamicUniformAllocator : no free instance, ", count, " allocations per frame");
+        }
+        const auto offset = (first + head) * buffer->getInstanceSizeAligned();
+        head += 1;
+        return {
+            static_cast<std::byte*>(buffer->getMappedAddress()) + offset,
+            offset,
+        };
+    }
+
+}
@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+export module vireo.uniforms;
+
+import std;
+import vireo;
+
+export namespace vireo {
+
+    /**
+     * Per-frame linear allocator of dynamic uniform data.
+     * Owns one persistently mapped UNIFORM buffer divided in one region per frame in flight. Each allocation returns
+     * a host pointer and the dynamic offset to give to CommandList::bindDescriptor(), so per-draw constants are
+     * written without any descriptor update. Offsets are multiples of Buffer::getInstanceSizeAligned() and respect the
+     * backend minimum uniform buffer offset alignment.
+     *
+     * The buffer must be bound once in a descriptor set created from
+     * Vireo::createDynamicUniformDescriptorLayout(), shared by all the frames.
+     *
+     * @warning Not thread-safe.
+     *
+     * Manual page : \ref manual_040_02_descriptor_set
+     */
+    class DynamicUniformAllocator {
+    public:
+        /**
+         * An allocated instance of uniform data
+         */
+        struct Allocation {
+            //! Host address of the data, valid until the region of the frame is reused
+            void*    data;
+            //! Dynamic offset for CommandList::bindDescriptor()
+            uint32_t offset;
+        };
+
+        /**
+         * Creates the uniform buffer and maps it
+         * @param vireo Vireo instance used to create the buffer
+         * @param size Size in bytes of the largest data instance
+         * @param count Maximum number of allocations per frame
+         * @param framesInFlight Number of frames the GPU can process while the CPU records the next one
+         * @param name Object name for debug
+         */
+        DynamicUniformAllocator(
+            const Vireo& vireo,
+            size_t size,
+            uint32_t count,
+            uint32_t framesInFlight,
+            const std::string& name = "DynamicUniformAllocator");
+
+        /**
+         * Starts the allocations of a frame, releasing all the allocations made the last time the region of this frame
+         * was used. Call after waiting for the fence of the frame.
+         * @param frameIndex Index of the frame, wrapped with the number of frames in flight
+         */
+        void beginFrame(uint32_t frameIndex);
+
+        /**
+         * Allocates one data instance in the region of the current frame. Throws an Exception if the region is full.
+         */
+        Allocation allocate();
+
+        /**
+         * Allocates one data instance and copies `data` into it
+         * @return The dynamic offset for CommandList::bindDescriptor()
+         */
+        template<typename T>
+        uint32_t push(const T& data) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            assert(sizeof(T) <= buffer->getInstanceSize());
+            const auto allocation = allocate();
+            std::memcpy(allocation.data, &data, sizeof(T));
+            return allocation.offset;
+        }
+
+        /**
+         * Returns the number of allocations made in the current frame
+         */
+        auto getAllocationCount() const { return head; }
+
+        /**
+         * Returns the uniform buffer to bind in the dynamic uniform descriptor set
+         */
+        const auto& getBuffer() const { return buffer; }
+
+        ~DynamicUniformAllocator();
+        DynamicUniformAllocator(const DynamicUniformAllocator&) = delete;
+        DynamicUniformAllocator& operator = (const DynamicUniformAllocator&) = delete;
+
+    private:
+        const uint32_t                count;
+        const uint32_t                framesInFlight;
+        const std::shared_ptr<Buffer> buffer;
+        // First instance of the region of the current frame
+        uint32_t                      first{0};
+        // Number of instances allocated in the current frame
+        uint32_t                      head{0};
+    };
+
+}
@@ -0,0 +1,93 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.profiler.gpu;
+
+namespace vireo {
+
+    GPUProfiler::GPUProfiler(
+        const Vireo& vireo,
+        const uint32_t framesInFlight,
+        const uint32_t maxScopes,
+        const std::string& name) :
+        maxScopes{maxScopes},
+        framesInFlight{framesInFlight},
+        queryPool{vireo.createQueryPool(maxScopes * 2 * framesInFlight, name)},
+        frames(framesInFlight) {
+        assert(maxScopes > 0);
+        assert(framesInFlight > 0);
+    }
+
+    void GPUProfiler::beginFrame(CommandList& commandList, const uint32_t frameIndex) {
+        assert(openedScopes.empty());
+        current = frameIndex % framesInFlight;
+        auto& frame = frames[current];
+        const auto firstQuery = current * maxScopes * 2;
+        if (frame.resolved) {
+            // The fence of the frame has been waited : the results are already in the readback buffer
+            const auto queryCount = static_cast<uint32_t>(frame.scopes.size() * 2);
+            const auto timestamps = queryPool->getResults(firstQuery, queryCount);
+            timings.clear();
+            for (int i = 0; i < frame.scopes.size(); i++) {
+                const auto& scope = frame.scopes[i];
+                const auto ticks = timestamps[i * 2 + 1] >= timestamps[i * 2] ?
+                    timestamps[i * 2 + 1] - timestamps[i * 2] :
+                    0;
+                timings.push_back({
+                    scope.name,
+                    scope.depth,
+                    scope.parent,
+                    static_cast<double>(ticks) * queryPool->getTimestampPeriodMs(),
+                });
+            }
+            frame.resolved = false;
+        }
+        frame.scopes.clear();
+        // One reset for all the slots of the frame instead of one per timestamp
+        commandList.resetQueryPool(*queryPool, firstQuery, maxScopes * 2);
+    }
+
+    void GPUProfiler::begin(CommandList& commandList, const std::string& name) {
+        auto& frame = frames[current];
+        if (frame.scopes.size() >= maxScopes) {
+            throw Exception("GPUProfiler : no free query, ", maxScopes, " scopes per frame");
+        }
+        const auto index = static_cast<int32_t>(frame.scopes.size());
+        frame.scopes.push_back({
+            name,
+            static_cast<uint32_t>(openedScopes.size()),
+            openedScopes.empty() ? -1 : openedScopes.back(),
+        });
+        openedScopes.push_back(index);
+        commandList.writeTimestamp(*queryPool, current * maxScopes * 2 + static_cast<uint32_t>(index) * 2);
+    }
+
+    void GPUProfiler::end(CommandList& commandList) {
+        assert(!openedScopes.empty());
+        const auto index = openedScopes.back();
+        openedScopes.pop_back();
+        // Written once all the commands of the scope are complete
+        commandList.writeTimestamp(
+            *queryPool,
+            current * maxScopes * 2 + static_cast<uint32_t>(index) * 2 + 1,
+            WaitStage::ALL_COMMANDS);
+    }
+
+    void GPUProfiler::endFrame(CommandList& commandList) {
+        assert(openedScopes.empty());
+        auto& frame = frames[current];
+        if (!frame.scopes.empty()) {
+            commandList.resolveQueryPool(
+                *queryPool,
+                current * maxScopes * 2,
+                static_cast<uint32_t>(frame.scopes.size() * 2));
+            frame.resolved = true;
+        }
+    }
+
+}
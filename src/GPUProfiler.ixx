@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.profiler.gpu;
+
+import std;
+import vireo;
+
+export namespace vireo {
+
+    /**
+     * Device side profiler measuring named and nested scopes of command lists with timestamp queries.
+     * Owns one QueryPool divided in one region per frame in flight. The region of a frame is reset with one command
+     * when the frame starts and resolved when the frame ends, the timings are read back when the region is reused,
+     * after the caller has waited for the fence of the frame : the readback never stalls and the timings are
+     * `framesInFlight` frames late.
+     *
+     * @warning Not thread-safe. The scopes of a frame must be recorded in submission order.
+     *
+     * Manual page : \ref manual_130_00_profiling
+     */
+    class GPUProfiler {
+    public:
+        /**
+         * Duration of a scope of the last read back frame
+         */
+        struct Timing {
+            //! Name of the scope
+            std::string name;
+            //! Nesting level, 0 for the top level scopes
+            uint32_t    depth;
+            //! Index of the enclosing scope in the timings, -1 for the top level scopes
+            int32_t     parent;
+            //! GPU duration in milliseconds
+            double      durationMs;
+        };
+
+        /**
+         * Scoped marker : records a scope from its construction to its destruction
+         */
+        class Scope {
+        public:
+            Scope(GPUProfiler& profiler, CommandList& commandList, const std::string& name) :
+                profiler{profiler},
+                commandList{commandList} {
+                profiler.begin(commandList, name);
+            }
+
+            ~Scope() {
+                profiler.end(commandList);
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator = (const Scope&) = delete;
+
+        private:
+            GPUProfiler& profiler;
+            CommandList& commandList;
+        };
+
+        /**
+         * Creates the query pool
+         * @param vireo Vireo instance used to create the query pool
+         * @param framesInFlight Number of frames the GPU can process while the CPU records the next one
+         * @param maxScopes Maximum number of scopes per frame
+         * @param name Object name for debug
+         */
+        GPUProfiler(
+            const Vireo& vireo,
+            uint32_t framesInFlight,
+            uint32_t maxScopes = 256,
+            const std::string& name = "GPUProfiler");
+
+        /**
+         * Reads back the timings of the last frame recorded in the region of this frame then resets the region.
+         * Call after waiting for the fence of the frame, in the first command list of the frame and outside of a
+         * rendering pass.
+         * @param commandList Command list recording the reset
+         * @param frameIndex Index of the frame, wrapped with the number of frames in flight
+         */
+        void beginFrame(CommandList& commandList, uint32_t frameIndex);
+
+        /**
+         * Starts a scope, nested in the currently opened scope if any.
+         * Throws an Exception if the maximum number of scopes of the frame is reached.
+         * @param commandList Command list recording the start timestamp
+         * @param name Name of the scope
+         */
+        void begin(CommandList& commandList, const std::string& name);
+
+        /**
+         * Ends the last opened scope
+         * @param commandList Command list recording the end timestamp
+         */
+        void end(CommandList& commandList);
+
+        /**
+         * Resolves the timestamps of the frame. Call in the last command list of the frame, after the end of all the
+         * scopes.
+         * @param commandList Command list recording the resolve
+         */
+        void endFrame(CommandList& commandList);
+
+        /**
+         * Returns the timings of the last read back frame in the order of the scopes starts, empty until the first
+         * frame has been read back
+         */
+        const auto& getTimings() const { return timings; }
+
+        /**
+         * Returns the maximum number of scopes per frame
+         */
+        auto getMaxScopes() const { return maxScopes; }
+
+    private:
+        // Scope started in a frame, its begin & end timestamps are the slots 2 * index and 2 * index + 1 of the region
+        struct ScopeQueries {
+            std::string name;
+            uint32_t    depth;
+            int32_t     parent;
+        };
+
+        struct Frame {
+            std::vector<ScopeQueries> scopes;
+            // The region has been resolved and not yet read back
+            bool                      resolved{false};
+        };
+
+        const uint32_t             maxScopes;
+        const uint32_t             framesInFlight;
+        std::shared_ptr<QueryPool> queryPool;
+        std::vector<Frame>         frames;
+        // Region of the frame being recorded
+        uint32_t                   current{0};
+        // Indices in the scopes of the current frame of the opened scopes
+        std::vector<int32_t>       openedScopes;
+        std::vector<Timing>        timings;
+    };
+
+}
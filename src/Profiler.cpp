@@ -0,0 +1,117 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module vireo.profiler;
+
+import vireo.tools;
+
+namespace vireo {
+
+    namespace {
+
+        struct ZoneEvent {
+            const char* name;
+            uint64_t    start;
+            uint64_t    end;
+        };
+
+        // Ring buffer of one thread. Only the owning thread writes the events and the head, the readers hold
+        // threadsMutex and only write the tail.
+        struct ThreadZones {
+            uint32_t               threadId;
+            std::vector<ZoneEvent> events = std::vector<ZoneEvent>(CPUProfiler::CAPACITY);
+            std::atomic<uint64_t>  head{0};
+            // Index of the first zone not yet written
+            uint64_t               tail{0};
+        };
+
+        std::mutex                                threadsMutex;
+        // Kept after the end of the threads to write their last zones
+        std::vector<std::shared_ptr<ThreadZones>> threads;
+        thread_local ThreadZones*                 currentThread{nullptr};
+
+        ThreadZones& getThreadZones() {
+            if (currentThread == nullptr) {
+                auto lock = std::lock_guard{threadsMutex};
+                const auto& zones = threads.emplace_back(std::make_shared<ThreadZones>());
+                zones->threadId = static_cast<uint32_t>(threads.size());
+                currentThread = zones.get();
+            }
+            return *currentThread;
+        }
+
+    }
+
+    std::atomic<bool> CPUProfiler::enabled{true};
+
+    void CPUProfiler::record(const char* name, const uint64_t start, const uint64_t end) {
+        auto& zones = getThreadZones();
+        const auto head = zones.head.load(std::memory_order_relaxed);
+        zones.events[head % CAPACITY] = { name, start, end };
+        zones.head.store(head + 1, std::memory_order_release);
+    }
+
+    void CPUProfiler::writeTrace(const std::string& fileName) {
+        auto file = std::ofstream{fileName};
+        if (!file) {
+            throw Exception("Error opening trace file ", fileName);
+        }
+        auto events = std::vector<std::pair<uint32_t, ZoneEvent>>{};
+        auto threadIds = std::vector<uint32_t>{};
+        {
+            auto lock = std::lock_guard{threadsMutex};
+            for (const auto& zones : threads) {
+                const auto head = zones->head.load(std::memory_order_acquire);
+                const auto first = std::max<uint64_t>(zones->tail, head > CAPACITY ? head - CAPACITY : 0);
+                const auto copied = events.size();
+                for (auto i = first; i < head; i++) {
+                    events.push_back({zones->threadId, zones->events[i % CAPACITY]});
+                }
+                // The zones overwritten by the thread during the copy are dropped, including the slot of the
+                // zone `last` which may be written while copied
+                const auto last = zones->head.load(std::memory_order_acquire);
+                if (last >= CAPACITY && last - CAPACITY + 1 > first) {
+                    const auto overwritten = std::min<uint64_t>(last - CAPACITY + 1 - first, head - first);
+                    events.erase(events.begin() + copied, events.begin() + copied + overwritten);
+                }
+                zones->tail = head;
+                threadIds.push_back(zones->threadId);
+            }
+        }
+
+        auto epoch = std::numeric_limits<uint64_t>::max();
+        for (const auto& [threadId, event] : events) {
+            epoch = std::min(epoch, event.start);
+        }
+        auto lines = std::vector<std::string>{};
+        for (const auto threadId : threadIds) {
+            lines.push_back(std::format(
+                R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"Thread {}"}}}})",
+                threadId, threadId));
+        }
+        for (const auto& [threadId, event] : events) {
+            lines.push_back(std::format(
+                R"({{"name":"{}","cat":"vireo","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                event.name,
+                threadId,
+                static_cast<double>(event.start - epoch) / 1000.0,
+                static_cast<double>(event.end - event.start) / 1000.0));
+        }
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (int i = 0; i < lines.size(); i++) {
+            file << lines[i] << (i + 1 < lines.size() ? ",\n" : "\n");
+        }
+        file << "]}\n";
+    }
+
+    void CPUProfiler::clear() {
+        auto lock = std::lock_guard{threadsMutex};
+        for (const auto& zones : threads) {
+            zones->tail = zones->head.load(std::memory_order_acquire);
+        }
+    }
+
+}
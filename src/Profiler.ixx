@@ -0,0 +1,102 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.profiler;
+
+import std;
+
+export namespace vireo {
+
+    /**
+     * Enabled with the VIREO_PROFILER CMake option, to collect the CPU profiling zones
+     */
+#ifdef VIREO_PROFILER
+    constexpr bool ENABLE_CPU_PROFILER = true;
+#else
+    constexpr bool ENABLE_CPU_PROFILER = false;
+#endif
+
+    /**
+     * Host side profiler. Zones are recorded by scoped markers in per-thread ring buffers, without locks, and written
+     * in the Chrome trace event format (chrome://tracing, Perfetto).
+     * The Vulkan backend places zones around submissions, swap chain acquire & present, pipeline creations, uploads
+     * and descriptor updates. Without ENABLE_CPU_PROFILER the markers are empty objects.
+     *
+     * Manual page : \ref manual_130_00_profiling
+     */
+    class CPUProfiler {
+    public:
+        //! Number of zones kept per thread, the oldest zones are overwritten
+        static constexpr size_t CAPACITY{16384};
+
+        /**
+         * Scoped marker : records a zone from its construction to its destruction
+         */
+        class Zone {
+        public:
+            /**
+             * Starts a zone
+             * @param name Name of the zone, must be a string literal or outlive the next writeTrace()
+             */
+            Zone(const char* name) {
+                if constexpr (ENABLE_CPU_PROFILER) {
+                    if (enabled.load(std::memory_order_relaxed)) {
+                        this->name = name;
+                        start = now();
+                    }
+                }
+            }
+
+            ~Zone() {
+                if constexpr (ENABLE_CPU_PROFILER) {
+                    if (this->name != nullptr) {
+                        record(this->name, start, now());
+                    }
+                }
+            }
+
+            Zone(const Zone&) = delete;
+            Zone& operator = (const Zone&) = delete;
+
+        private:
+            const char* name{nullptr};
+            uint64_t    start{0};
+        };
+
+        /**
+         * Starts or stops the recording of the zones, enabled by default
+         */
+        static void setEnabled(const bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+        /**
+         * Returns `true` if the zones are recorded
+         */
+        static bool isEnabled() { return ENABLE_CPU_PROFILER && enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * Writes the zones recorded by all the threads since the last write in a Chrome trace event JSON file,
+         * then removes them. Throws an Exception if the file can't be written.
+         */
+        static void writeTrace(const std::string& fileName);
+
+        /**
+         * Removes the zones recorded by all the threads
+         */
+        static void clear();
+
+    private:
+        static std::atomic<bool> enabled;
+
+        // Nanoseconds
+        static uint64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static void record(const char* name, uint64_t start, uint64_t end);
+    };
+
+}
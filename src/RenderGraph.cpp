@@ -0,0 +1,293 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.rendergraph;
+
+import vireo.tools;
+
+namespace vireo {
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::read(
+        const std::shared_ptr<const Image>& image,
+        const ResourceState state) {
+        graph.addAccess(pass, graph.getResource(image), state, false);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::read(
+        const std::shared_ptr<const RenderTarget>& renderTarget,
+        const ResourceState state) {
+        assert(renderTarget != nullptr);
+        return read(std::shared_ptr<const Image>(renderTarget->getImage()), state);
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::read(
+        const std::shared_ptr<const Buffer>& buffer,
+        const ResourceState state) {
+        graph.addAccess(pass, graph.getResource(buffer), state, false);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(
+        const std::shared_ptr<const Image>& image,
+        const ResourceState state) {
+        graph.addAccess(pass, graph.getResource(image), state, true);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(
+        const std::shared_ptr<const RenderTarget>& renderTarget,
+        const ResourceState state) {
+        assert(renderTarget != nullptr);
+        return write(std::shared_ptr<const Image>(renderTarget->getImage()), state);
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(
+        const std::shared_ptr<const Buffer>& buffer,
+        const ResourceState state) {
+        graph.addAccess(pass, graph.getResource(buffer), state, true);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(
+        const std::shared_ptr<const SwapChain>& swapChain,
+        const ResourceState state) {
+        graph.addAccess(pass, graph.getResource(swapChain), state, true);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::rendering(const RenderingConfiguration& configuration) {
+        for (const auto& colorRenderTarget : configuration.colorRenderTargets) {
+            if (colorRenderTarget.swapChain) {
+                write(std::shared_ptr<const SwapChain>(colorRenderTarget.swapChain));
+            }
+            if (colorRenderTarget.renderTarget) {
+                write(std::shared_ptr<const RenderTarget>(colorRenderTarget.renderTarget));
+            }
+            if (colorRenderTarget.multisampledRenderTarget) {
+                write(std::shared_ptr<const RenderTarget>(colorRenderTarget.multisampledRenderTarget));
+            }
+        }
+        for (const auto& depthRenderTarget : {
+            configuration.depthStencilRenderTarget,
+            configuration.multisampledDepthStencilRenderTarget }) {
+            if (depthRenderTarget) {
+                write(
+                    std::shared_ptr<const RenderTarget>(depthRenderTarget),
+                    depthRenderTarget->getImage()->isDepthStencilFormat() ?
+                        ResourceState::RENDER_TARGET_DEPTH_STENCIL :
+                        ResourceState::RENDER_TARGET_DEPTH);
+            }
+        }
+        graph.passes[pass].rendering = configuration;
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::sideEffect() {
+        graph.passes[pass].sideEffect = true;
+        return *this;
+    }
+
+    RenderGraph::PassBuilder RenderGraph::addPass(const std::string& name, const Execute& execute) {
+        passes.push_back({ .name = name, .execute = execute });
+        compiled = false;
+        return {*this, static_cast<uint32_t>(passes.size() - 1)};
+    }
+
+    uint32_t RenderGraph::getResource(const void* key, const Object& object) {
+        assert(key != nullptr);
+        const auto it = resourceIndices.find(key);
+        if (it != resourceIndices.end()) {
+            return it->second;
+        }
+        resources.push_back({ .object = object });
+        compiled = false;
+        return resourceIndices[key] = static_cast<uint32_t>(resources.size() - 1);
+    }
+
+    uint32_t RenderGraph::getResource(const std::shared_ptr<const Image>& image) {
+        return getResource(image.get(), image);
+    }
+
+    uint32_t RenderGraph::getResource(const std::shared_ptr<const Buffer>& buffer) {
+        return getResource(buffer.get(), buffer);
+    }
+
+    uint32_t RenderGraph::getResource(const std::shared_ptr<const SwapChain>& swapChain) {
+        return getResource(swapChain.get(), swapChain);
+    }
+
+    void RenderGraph::addAccess(const uint32_t pass, const uint32_t resource, const ResourceState state, const bool write) {
+        auto& accesses = passes[pass].accesses;
+        const auto it = std::ranges::find_if(accesses, [resource](const Access& access) {
+            return access.resource == resource;
+        });
+        if (it == accesses.end()) {
+            accesses.push_back({ resource, state, write });
+        } else if (it->state == state) {
+            it->write |= write;
+        } else {
+            throw Exception("RenderGraph : resource used with two different states in pass ", passes[pass].name);
+        }
+        compiled = false;
+    }
+
+    void RenderGraph::importResource(const std::shared_ptr<const Image>& image, const ResourceState state) {
+        resources[getResource(image)].initialState = state;
+        compiled = false;
+    }
+
+    void RenderGraph::importResource(const std::shared_ptr<const RenderTarget>& renderTarget, const ResourceState state) {
+        assert(renderTarget != nullptr);
+        importResource(std::shared_ptr<const Image>(renderTarget->getImage()), state);
+    }
+
+    void RenderGraph::importResource(const std::shared_ptr<const Buffer>& buffer, const ResourceState state) {
+        resources[getResource(buffer)].initialState = state;
+        compiled = false;
+    }
+
+    void RenderGraph::importResource(const std::shared_ptr<const SwapChain>& swapChain, const ResourceState state) {
+        resources[getResource(swapChain)].initialState = state;
+        compiled = false;
+    }
+
+    void RenderGraph::exportResource(const std::shared_ptr<const Image>& image, const ResourceState state) {
+        resources[getResource(image)].finalState = state;
+        compiled = false;
+    }
+
+    void RenderGraph::exportResource(const std::shared_ptr<const RenderTarget>& renderTarget, const ResourceState state) {
+        assert(renderTarget != nullptr);
+        exportResource(std::shared_ptr<const Image>(renderTarget->getImage()), state);
+    }
+
+    void RenderGraph::exportResource(const std::shared_ptr<const Buffer>& buffer, const ResourceState state) {
+        resources[getResource(buffer)].finalState = state;
+        compiled = false;
+    }
+
+    void RenderGraph::exportResource(const std::shared_ptr<const SwapChain>& swapChain, const ResourceState state) {
+        resources[getResource(swapChain)].finalState = state;
+        compiled = false;
+    }
+
+    void RenderGraph::compile() {
+        // Culling : walk the passes backward, a pass is kept if it has side effects or if it writes a
+        // resource exported or read by a pass kept after it
+        auto needed = std::vector<bool>(resources.size(), false);
+        for (uint32_t i = 0; i < resources.size(); i++) {
+            needed[i] = resources[i].finalState.has_value();
+        }
+        culledPassCount = 0;
+        for (auto& pass : std::views::reverse(passes)) {
+            pass.culled = !pass.sideEffect && std::ranges::none_of(pass.accesses, [&](const Access& access) {
+                return access.write && needed[access.resource];
+            });
+            if (pass.culled) {
+                culledPassCount++;
+                continue;
+            }
+            // Written resources stay needed : a previous write may be loaded by this pass
+            for (const auto& access : pass.accesses) {
+                needed[access.resource] = true;
+            }
+        }
+
+        // Transitions : a transition is needed when the state changes. Without a state change, a resource written by
+        // a previous pass still needs a memory barrier before being read or written again, and a resource read by a
+        // previous pass needs an execution barrier before being written. Reads never wait for reads.
+        auto states = std::vector<ResourceState>(resources.size());
+        for (uint32_t i = 0; i < resources.size(); i++) {
+            states[i] = resources[i].initialState;
+        }
+        // Resources written or read by a previous pass and not synchronized since
+        auto pendingWrites = std::vector<bool>(resources.size(), false);
+        auto pendingReads = std::vector<bool>(resources.size(), false);
+        transitionCount = 0;
+        memoryBarrierCount = 0;
+        for (auto& pass : passes) {
+            pass.transitions.clear();
+            pass.memoryBarriers.clear();
+            if (pass.culled) { continue; }
+            for (const auto& access : pass.accesses) {
+                if (states[access.resource] != access.state) {
+                    pass.transitions.push_back({ access.resource, states[access.resource], access.state });
+                    states[access.resource] = access.state;
+                } else if ((pendingWrites[access.resource] || (access.write && pendingReads[access.resource])) &&
+                           std::ranges::find(pass.memoryBarriers, access.state) == pass.memoryBarriers.end()) {
+                    // One global barrier per state for all the resources of the pass
+                    pass.memoryBarriers.push_back(access.state);
+                }
+            }
+            // The accesses of the pass are the only ones not synchronized with the next passes
+            for (const auto& access : pass.accesses) {
+                pendingWrites[access.resource] = access.write;
+                pendingReads[access.resource] = !access.write;
+            }
+            transitionCount += pass.transitions.size();
+            memoryBarrierCount += pass.memoryBarriers.size();
+        }
+        finalTransitions.clear();
+        for (uint32_t i = 0; i < resources.size(); i++) {
+            if (resources[i].finalState && *resources[i].finalState != states[i]) {
+                finalTransitions.push_back({ i, states[i], *resources[i].finalState });
+            }
+        }
+        transitionCount += finalTransitions.size();
+        compiled = true;
+    }
+
+    void RenderGraph::recordTransitions(
+        CommandList& commandList,
+        const std::vector<Transition>& transitions,
+        const std::vector<ResourceState>& memoryBarriers) const {
+        if (transitions.empty() && memoryBarriers.empty()) { return; }
+        // All the transitions of a pass boundary are recorded with a single barrier command
+        auto batch = BarrierBatch{};
+        for (const auto& transition : transitions) {
+            std::visit([&](const auto& object) {
+                batch.add(object, transition.oldState, transition.newState);
+            }, resources[transition.resource].object);
+        }
+        for (const auto state : memoryBarriers) {
+            batch.add(state, state);
+        }
+        commandList.barrier(batch);
+    }
+
+    void RenderGraph::execute(CommandList& commandList) {
+        if (!compiled) {
+            compile();
+        }
+        for (const auto& pass : passes) {
+            if (pass.culled) { continue; }
+            recordTransitions(commandList, pass.transitions, pass.memoryBarriers);
+            if (pass.rendering) {
+                commandList.beginRendering(*pass.rendering);
+            }
+            pass.execute(commandList);
+            if (pass.rendering) {
+                commandList.endRendering();
+            }
+        }
+        recordTransitions(commandList, finalTransitions, {});
+    }
+
+    void RenderGraph::reset() {
+        resources.clear();
+        resourceIndices.clear();
+        passes.clear();
+        finalTransitions.clear();
+        compiled = false;
+        culledPassCount = 0;
+        transitionCount = 0;
+        memoryBarrierCount = 0;
+    }
+
+}
@@ -0,0 +1,249 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.rendergraph;
+
+import std;
+import vireo;
+
+export namespace vireo {
+
+    /**
+     * A frame graph recorded on top of a CommandList.
+     * Passes declare the images, buffers, render targets and swap chains they read and write. The graph culls the
+     * passes which do not contribute to an exported resource, computes the state transitions between the passes
+     * and records them, batched per pass boundary, before calling each pass.
+     *
+     * The graph is rebuilt each frame : declare the resources and passes, call execute() then reset().
+     *
+     * Manual page : \ref manual_090_04_render_graph
+     */
+    class RenderGraph {
+    public:
+        /**
+         * Function recording the commands of a pass
+         */
+        using Execute = std::function<void(CommandList&)>;
+
+        /**
+         * Declares the resources used by a pass.
+         * A resource can only be used with one state in a given pass.
+         */
+        class PassBuilder {
+        public:
+            /**
+             * Declares a read of an image
+             * @param image The image
+             * @param state State of the image during the pass
+             */
+            PassBuilder& read(const std::shared_ptr<const Image>& image, ResourceState state = ResourceState::SHADER_READ);
+
+            /**
+             * Declares a read of the image of a render target
+             * @param renderTarget The render target
+             * @param state State of the image during the pass
+             */
+            PassBuilder& read(const std::shared_ptr<const RenderTarget>& renderTarget, ResourceState state = ResourceState::SHADER_READ);
+
+            /**
+             * Declares a read of a buffer
+             * @param buffer The buffer
+             * @param state State of the buffer during the pass
+             */
+            PassBuilder& read(const std::shared_ptr<const Buffer>& buffer, ResourceState state = ResourceState::SHADER_READ);
+
+            /**
+             * Declares a write of an image
+             * @param image The image
+             * @param state State of the image during the pass
+             */
+            PassBuilder& write(const std::shared_ptr<const Image>& image, ResourceState state = ResourceState::COMPUTE_WRITE);
+
+            /**
+             * Declares a write of the image of a render target
+             * @param renderTarget The render target
+             * @param state State of the image during the pass
+             */
+            PassBuilder& write(const std::shared_ptr<const RenderTarget>& renderTarget, ResourceState state = ResourceState::RENDER_TARGET_COLOR);
+
+            /**
+             * Declares a write of a buffer
+             * @param buffer The buffer
+             * @param state State of the buffer during the pass
+             */
+            PassBuilder& write(const std::shared_ptr<const Buffer>& buffer, ResourceState state = ResourceState::COMPUTE_WRITE);
+
+            /**
+             * Declares a write of the current image of a swap chain
+             * @param swapChain The swap chain
+             * @param state State of the image during the pass
+             */
+            PassBuilder& write(const std::shared_ptr<const SwapChain>& swapChain, ResourceState state = ResourceState::RENDER_TARGET_COLOR);
+
+            /**
+             * Records the pass inside a render pass. All the attachments of the configuration are declared as written.
+             * @param configuration Attachments used by CommandList::beginRendering
+             */
+            PassBuilder& rendering(const RenderingConfiguration& configuration);
+
+            /**
+             * Marks the pass as having side effects outside the graph (readbacks, queries...) : it is never culled
+             */
+            PassBuilder& sideEffect();
+
+        private:
+            RenderGraph& graph;
+            const uint32_t pass;
+
+            PassBuilder(RenderGraph& graph, uint32_t pass) : graph{graph}, pass{pass} {}
+
+            friend class RenderGraph;
+        };
+
+        /**
+         * Adds a pass to the graph. Passes are executed in the order they are added.
+         * @param name Name of the pass, for debug
+         * @param execute Function recording the commands of the pass
+         * @return A builder used to declare the resources of the pass
+         */
+        PassBuilder addPass(const std::string& name, const Execute& execute);
+
+        /**
+         * Sets the state of an image at the start of the graph. Resources not imported start in ResourceState::UNDEFINED
+         */
+        void importResource(const std::shared_ptr<const Image>& image, ResourceState state);
+
+        /**
+         * Sets the state of the image of a render target at the start of the graph
+         */
+        void importResource(const std::shared_ptr<const RenderTarget>& renderTarget, ResourceState state);
+
+        /**
+         * Sets the state of a buffer at the start of the graph
+         */
+        void importResource(const std::shared_ptr<const Buffer>& buffer, ResourceState state);
+
+        /**
+         * Sets the state of a swap chain image at the start of the graph
+         */
+        void importResource(const std::shared_ptr<const SwapChain>& swapChain, ResourceState state);
+
+        /**
+         * Marks an image as an output of the graph, transitioned to `state` after the last pass
+         */
+        void exportResource(const std::shared_ptr<const Image>& image, ResourceState state);
+
+        /**
+         * Marks the image of a render target as an output of the graph, transitioned to `state` after the last pass
+         */
+        void exportResource(const std::shared_ptr<const RenderTarget>& renderTarget, ResourceState state);
+
+        /**
+         * Marks a buffer as an output of the graph, transitioned to `state` after the last pass
+         */
+        void exportResource(const std::shared_ptr<const Buffer>& buffer, ResourceState state);
+
+        /**
+         * Marks a swap chain as an output of the graph, transitioned to `state` (usually ResourceState::PRESENT)
+         * after the last pass
+         */
+        void exportResource(const std::shared_ptr<const SwapChain>& swapChain, ResourceState state);
+
+        /**
+         * Culls the unused passes and computes the transitions. Called by execute() if needed.
+         */
+        void compile();
+
+        /**
+         * Records the transitions and the passes in a command list, between CommandList::begin and CommandList::end
+         */
+        void execute(CommandList& commandList);
+
+        /**
+         * Removes all the passes and resources
+         */
+        void reset();
+
+        /**
+         * Returns the number of passes culled by the last compilation
+         */
+        auto getCulledPassCount() const { return culledPassCount; }
+
+        /**
+         * Returns the number of transitions recorded by the last compilation
+         */
+        auto getTransitionCount() const { return transitionCount; }
+
+        /**
+         * Returns the number of memory barriers recorded by the last compilation, between passes accessing a
+         * written resource, or writing a read resource, in the same state
+         */
+        auto getMemoryBarrierCount() const { return memoryBarrierCount; }
+
+    private:
+        using Object = std::variant<
+            std::shared_ptr<const Image>,
+            std::shared_ptr<const Buffer>,
+            std::shared_ptr<const SwapChain>>;
+
+        struct Resource {
+            Object                       object;
+            ResourceState                initialState{ResourceState::UNDEFINED};
+            std::optional<ResourceState> finalState;
+        };
+
+        struct Access {
+            uint32_t      resource;
+            ResourceState state;
+            bool          write;
+        };
+
+        struct Transition {
+            uint32_t      resource;
+            ResourceState oldState;
+            ResourceState newState;
+        };
+
+        struct Pass {
+            std::string                           name;
+            Execute                               execute;
+            std::vector<Access>                   accesses;
+            std::optional<RenderingConfiguration> rendering;
+            bool                                  sideEffect{false};
+            bool                                  culled{false};
+            // Transitions recorded before the pass
+            std::vector<Transition>               transitions;
+            // States of the global memory barriers recorded before the pass
+            std::vector<ResourceState>            memoryBarriers;
+        };
+
+        std::vector<Resource>                    resources;
+        std::unordered_map<const void*, uint32_t> resourceIndices;
+        std::vector<Pass>                        passes;
+        // Transitions recorded after the last pass
+        std::vector<Transition>                  finalTransitions;
+        bool                                     compiled{false};
+        uint32_t                                 culledPassCount{0};
+        uint32_t                                 transitionCount{0};
+        uint32_t                                 memoryBarrierCount{0};
+
+        uint32_t getResource(const void* key, const Object& object);
+
+        uint32_t getResource(const std::shared_ptr<const Image>& image);
+
+        uint32_t getResource(const std::shared_ptr<const Buffer>& buffer);
+
+        uint32_t getResource(const std::shared_ptr<const SwapChain>& swapChain);
+
+        void addAccess(uint32_t pass, uint32_t resource, ResourceState state, bool write);
+
+        void recordTransitions(
+            CommandList& commandList,
+            const std::vector<Transition>& transitions,
+            const std::vector<ResourceState>& memoryBarriers) const;
+    };
+
+}
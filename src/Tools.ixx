@@ -7,6 +7,11 @@
 module;
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 export module vireo.tools;
 
@@ -98,4 +103,97 @@ export namespace std {
 #endif
 
 
-}
\ No newline at end of file
+}
+
+export namespace vireo {
+
+    /**
+     * Read-only memory mapping of a whole file.
+     * The data stays valid until the object is destroyed.
+     */
+    class MappedFile {
+    public:
+        /**
+         * Maps a file in memory
+         * @param fileName File name, with the extension
+         */
+        MappedFile(const std::string& fileName) {
+#ifdef _WIN32
+            file = CreateFileW(std::to_wstring(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw Exception("failed to open file ", fileName);
+            }
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize)) {
+                CloseHandle(file);
+                throw Exception("failed to get the size of file ", fileName);
+            }
+            size = static_cast<size_t>(fileSize.QuadPart);
+            if (size > 0) {
+                mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping == nullptr) {
+                    CloseHandle(file);
+                    throw Exception("failed to map file ", fileName);
+                }
+                data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+#else
+            file = open(fileName.c_str(), O_RDONLY);
+            if (file == -1) {
+                throw Exception("failed to open file ", fileName);
+            }
+            struct stat fileStat;
+            if (fstat(file, &fileStat) == -1) {
+                ::close(file);
+                throw Exception("failed to get the size of file ", fileName);
+            }
+            size = static_cast<size_t>(fileStat.st_size);
+            if (size > 0) {
+                void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+                data = address == MAP_FAILED ? nullptr : static_cast<const std::byte*>(address);
+            }
+#endif
+            if (size > 0 && data == nullptr) {
+                close();
+                throw Exception("failed to map file ", fileName);
+            }
+        }
+
+        ~MappedFile() {
+            close();
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+
+        /** Returns the address of the first byte of the file, page aligned. `nullptr` for empty files */
+        auto getData() const { return data; }
+
+        /** Returns the size of the file in bytes */
+        auto getSize() const { return size; }
+
+    private:
+#ifdef _WIN32
+        HANDLE file{INVALID_HANDLE_VALUE};
+        HANDLE mapping{nullptr};
+#else
+        int    file{-1};
+#endif
+        const std::byte* data{nullptr};
+        size_t           size{0};
+
+        void close() {
+#ifdef _WIN32
+            if (data) { UnmapViewOfFile(data); }
+            if (mapping) { CloseHandle(mapping); }
+            if (file != INVALID_HANDLE_VALUE) { CloseHandle(file); }
+#else
+            if (data) { munmap(const_cast<std::byte*>(data), size); }
+            if (file != -1) { ::close(file); }
+#endif
+            data = nullptr;
+        }
+    };
+
+}
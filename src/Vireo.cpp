@@ -11,6 +11,7 @@ module vireo;
 
 import std;
 import vireo.tools;
+import vireo.null;
 import vireo.vulkan;
 #ifdef DIRECTX_BACKEND
 import vireo.directx;
@@ -24,10 +25,47 @@ namespace vireo {
     std::mutex Image::memoryAllocationsMutex;
     std::list<VideoMemoryAllocationDesc> Image::memoryAllocations{};
 
+    std::list<VideoMemoryAllocationDesc> Buffer::getMemoryAllocations() {
+        auto lock = std::lock_guard(memoryAllocationsMutex);
+        return memoryAllocations;
+    }
+
+    void Buffer::addMemoryAllocation(const VideoMemoryAllocationDesc& desc) {
+        auto lock = std::lock_guard(memoryAllocationsMutex);
+        memoryAllocation = memoryAllocations.insert(memoryAllocations.end(), desc);
+    }
+
+    Buffer::~Buffer() {
+        if (memoryAllocation) {
+            auto lock = std::lock_guard(memoryAllocationsMutex);
+            memoryAllocations.erase(*memoryAllocation);
+        }
+    }
+
+    std::list<VideoMemoryAllocationDesc> Image::getMemoryAllocations() {
+        auto lock = std::lock_guard(memoryAllocationsMutex);
+        return memoryAllocations;
+    }
+
+    void Image::addMemoryAllocation(const VideoMemoryAllocationDesc& desc) {
+        auto lock = std::lock_guard(memoryAllocationsMutex);
+        memoryAllocation = memoryAllocations.insert(memoryAllocations.end(), desc);
+    }
+
+    Image::~Image() {
+        if (memoryAllocation) {
+            auto lock = std::lock_guard(memoryAllocationsMutex);
+            memoryAllocations.erase(*memoryAllocation);
+        }
+    }
+
     std::shared_ptr<Vireo> Vireo::create(const BackendConfiguration& configuration) {
         if (configuration.backend == Backend::VULKAN) {
             return std::make_shared<VKVireo>(configuration);
         }
+        if (configuration.backend == Backend::NULL_RECORDER) {
+            return std::make_shared<NullVireo>(configuration);
+        }
 #ifdef DIRECTX_BACKEND
         return std::make_shared<DXVireo>(configuration);
 #endif
@@ -38,7 +76,7 @@ namespace vireo {
 #ifdef DIRECTX_BACKEND
         if (backend == Backend::DIRECTX) { return true; }
 #endif
-        return backend == Backend::VULKAN;
+        return backend == Backend::VULKAN || backend == Backend::NULL_RECORDER;
     }
 
     std::shared_ptr<DescriptorLayout> Vireo::createDynamicUniformDescriptorLayout(
@@ -49,6 +87,350 @@ namespace vireo {
         return layout;
     }
 
+    uint64_t ShaderPack::hash(const std::string& name) {
+        // FNV-1a
+        auto hash = uint64_t{0xcbf29ce484222325};
+        for (const auto c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+        }
+        return hash;
+    }
+
+    std::optional<size_t> ShaderPack::find(const std::string& name) const {
+        const auto nameHash = hash(name);
+        const auto first = std::ranges::lower_bound(hashes, nameHash);
+        for (auto it = first; it != hashes.end() && *it == nameHash; ++it) {
+            const auto index = static_cast<size_t>(it - hashes.begin());
+            if (names[index] == name) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::shared_ptr<ShaderModule> ShaderPack::get(const std::string& name) const {
+        const auto index = find(name);
+        if (!index) {
+            throw Exception("shader ", name, " not found in shader pack");
+        }
+        return modules[*index];
+    }
+
+    void ShaderPack::write(
+        const std::string& fileName,
+        const std::vector<std::pair<std::string, std::vector<char>>>& shaders) {
+        auto entries = std::vector<Entry>(shaders.size());
+        auto order = std::vector<size_t>(shaders.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, {}, [&](const size_t i) { return hash(shaders[i].first); });
+
+        // Table of contents, then the names, then the aligned code
+        auto offset = static_cast<uint64_t>(sizeof(Header) + sizeof(Entry) * shaders.size());
+        for (int i = 0; i < order.size(); i++) {
+            const auto& name = shaders[order[i]].first;
+            entries[i].nameHash = hash(name);
+            entries[i].nameOffset = static_cast<uint32_t>(offset);
+            entries[i].nameSize = static_cast<uint32_t>(name.size());
+            offset += name.size();
+        }
+        for (int i = 0; i < order.size(); i++) {
+            offset = (offset + CODE_ALIGNMENT - 1) & ~(CODE_ALIGNMENT - 1);
+            entries[i].codeOffset = offset;
+            entries[i].codeSize = shaders[order[i]].second.size();
+            if (entries[i].codeSize == 0) {
+                throw Exception("empty shader ", shaders[order[i]].first, " in shader pack ", fileName);
+            }
+            offset += entries[i].codeSize;
+        }
+
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw Exception("failed to open shader pack file ", fileName);
+        }
+        const auto header = Header {
+            .magic = MAGIC,
+            .version = VERSION,
+            .entryCount = static_cast<uint32_t>(shaders.size()),
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(reinterpret_cast<const char*>(entries.data()), sizeof(Entry) * entries.size());
+        for (const auto i : order) {
+            file.write(shaders[i].first.data(), shaders[i].first.size());
+        }
+        for (int i = 0; i < order.size(); i++) {
+            static constexpr char padding[CODE_ALIGNMENT]{};
+            file.write(padding, static_cast<std::streamsize>(entries[i].codeOffset - static_cast<uint64_t>(file.tellp())));
+            file.write(shaders[order[i]].second.data(), entries[i].codeSize);
+        }
+        file.flush();
+        if (!file) {
+            throw Exception("failed to write shader pack file ", fileName);
+        }
+    }
+
+    std::shared_ptr<ShaderPack> Vireo::loadShaderPack(const std::string& fileName) const {
+        assert(!fileName.empty());
+        const auto packFileName = fileName + getShaderFileExtension() + ShaderPack::FILE_EXTENSION;
+        const auto file = MappedFile(packFileName);
+        const auto* data = file.getData();
+        const auto size = file.getSize();
+
+        auto header = ShaderPack::Header{};
+        if (size < sizeof(header)) {
+            throw Exception("invalid shader pack ", packFileName);
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != ShaderPack::MAGIC ||
+            header.version != ShaderPack::VERSION ||
+            sizeof(header) + sizeof(ShaderPack::Entry) * static_cast<uint64_t>(header.entryCount) > size) {
+            throw Exception("invalid shader pack ", packFileName);
+        }
+        auto entries = std::vector<ShaderPack::Entry>(header.entryCount);
+        std::memcpy(entries.data(), data + sizeof(header), sizeof(ShaderPack::Entry) * entries.size());
+
+        auto pack = std::make_shared<ShaderPack>();
+        pack->hashes.resize(entries.size());
+        pack->names.resize(entries.size());
+        pack->modules.resize(entries.size());
+        for (int i = 0; i < entries.size(); i++) {
+            const auto& entry = entries[i];
+            if (static_cast<uint64_t>(entry.nameOffset) + entry.nameSize > size ||
+                // Written to not wrap around with corrupted offsets
+                entry.codeSize == 0 ||
+                entry.codeOffset > size ||
+                entry.codeSize > size - entry.codeOffset ||
+                entry.codeOffset % sizeof(uint32_t) != 0 ||
+                entry.codeSize % sizeof(uint32_t) != 0 ||
+                (i > 0 && entry.nameHash < entries[i - 1].nameHash)) {
+                throw Exception("invalid shader pack ", packFileName);
+            }
+            pack->hashes[i] = entry.nameHash;
+            pack->names[i] = std::string(reinterpret_cast<const char*>(data + entry.nameOffset), entry.nameSize);
+        }
+
+        // The modules are created by the compilation threads before the queued pipeline compilations, the code is
+        // read directly from the mapped file
+        static constexpr size_t MODULES_PER_TASK{16};
+        auto futures = std::vector<std::future<void>>{};
+        for (auto first = size_t{0}; first < entries.size(); first += MODULES_PER_TASK) {
+            auto task = std::packaged_task<void()>{[&, first] {
+                const auto last = std::min(first + MODULES_PER_TASK, entries.size());
+                for (auto i = first; i < last; i++) {
+                    pack->modules[i] = createShaderModule(
+                        { reinterpret_cast<const uint32_t*>(data + entries[i].codeOffset),
+                          entries[i].codeSize / sizeof(uint32_t) },
+                        pack->names[i]);
+                }
+            }};
+            futures.push_back(task.get_future());
+            addCompilationTask(std::move(task), true);
+        }
+        // Wait for all the tasks before rethrowing : they use the mapped file
+        for (auto& future : futures) {
+            future.wait();
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        return pack;
+    }
+
+    AsyncPipeline<ComputePipeline> Vireo::createComputePipelineAsync(
+        const std::shared_ptr<PipelineResources>& pipelineResources,
+        const std::shared_ptr<const ShaderModule>& shader,
+        const std::shared_ptr<ComputePipeline>& fallback,
+        const std::string& name) const {
+        auto task = std::packaged_task<std::shared_ptr<ComputePipeline>()>{[this, pipelineResources, shader, name] {
+            return createComputePipeline(pipelineResources, shader, name);
+        }};
+        auto future = task.get_future().share();
+        addCompilationTask(std::move(task));
+        return {future, fallback};
+    }
+
+    AsyncPipeline<GraphicPipeline> Vireo::createGraphicPipelineAsync(
+        const GraphicPipelineConfiguration& configuration,
+        const std::shared_ptr<GraphicPipeline>& fallback,
+        const std::string& name) const {
+        // The configuration is copied : it keeps the shaders and resources alive during the compilation
+        auto task = std::packaged_task<std::shared_ptr<GraphicPipeline>()>{[this, configuration, name] {
+            return createGraphicPipeline(configuration, name);
+        }};
+        auto future = task.get_future().share();
+        addCompilationTask(std::move(task));
+        return {future, fallback};
+    }
+
+    size_t Vireo::hash(const GraphicPipelineConfiguration& configuration) {
+        auto seed = size_t{0};
+        const auto combine = [&seed](const auto& value) {
+            seed ^= std::hash<std::remove_cvref_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        combine(configuration.resources.get());
+        for (const auto format : configuration.colorRenderFormats) {
+            combine(format);
+        }
+        for (const auto& blend : configuration.colorBlendDesc) {
+            combine(blend.blendEnable);
+            combine(blend.srcColorBlendFactor);
+            combine(blend.dstColorBlendFactor);
+            combine(blend.colorBlendOp);
+            combine(blend.srcAlphaBlendFactor);
+            combine(blend.dstAlphaBlendFactor);
+            combine(blend.alphaBlendOp);
+            combine(blend.colorWriteMask);
+        }
+        combine(configuration.vertexInputLayout.get());
+        combine(configuration.vertexShader.get());
+        combine(configuration.fragmentShader.get());
+        combine(configuration.hullShader.get());
+        combine(configuration.domainShader.get());
+        combine(configuration.geometryShader.get());
+        combine(configuration.primitiveTopology);
+        combine(configuration.msaa);
+        combine(configuration.cullMode);
+        combine(configuration.polygonMode);
+        combine(configuration.frontFaceCounterClockwise);
+        combine(configuration.depthStencilImageFormat);
+        combine(configuration.depthTestEnable);
+        combine(configuration.depthWriteEnable);
+        combine(configuration.depthCompareOp);
+        combine(configuration.depthBiasEnable);
+        combine(configuration.depthBiasConstantFactor);
+        combine(configuration.depthBiasClamp);
+        combine(configuration.depthBiasSlopeFactor);
+        combine(configuration.stencilTestEnable);
+        for (const auto& stencil : { configuration.frontStencilOpState, configuration.backStencilOpState }) {
+            combine(stencil.failOp);
+            combine(stencil.passOp);
+            combine(stencil.depthFailOp);
+            combine(stencil.compareOp);
+            combine(stencil.compareMask);
+            combine(stencil.writeMask);
+        }
+        combine(configuration.logicOpEnable);
+        combine(configuration.logicOp);
+        combine(configuration.alphaToCoverageEnable);
+        return seed;
+    }
+
+    std::shared_ptr<GraphicPipeline> Vireo::getGraphicPipeline(
+        const GraphicPipelineConfiguration& configuration,
+        const std::string& name) const {
+        const auto key = hash(configuration);
+        const auto find = [&]() -> std::shared_ptr<GraphicPipeline> {
+            const auto [first, last] = pipelines.equal_range(key);
+            for (auto it = first; it != last; ++it) {
+                if (it->second.configuration == configuration) {
+                    if (auto pipeline = it->second.pipeline.lock()) {
+                        return pipeline;
+                    }
+                }
+            }
+            return nullptr;
+        };
+        {
+            auto lock = std::lock_guard{pipelinesMutex};
+            if (auto pipeline = find()) {
+                return pipeline;
+            }
+        }
+        // The pipeline is compiled without the lock, the other threads can use the registry in the meantime
+        auto pipeline = createGraphicPipeline(configuration, name);
+        auto lock = std::lock_guard{pipelinesMutex};
+        if (auto registered = find()) {
+            // Created by another thread during the compilation
+            return registered;
+        }
+        if (pipelines.size() >= pipelinesSweepSize) {
+            std::erase_if(pipelines, [](const auto& entry) {
+                return entry.second.pipeline.expired();
+            });
+            pipelinesSweepSize = std::max(pipelinesSweepSize, pipelines.size() * 2);
+        }
+        pipelines.emplace(key, RegisteredPipeline{ configuration, pipeline });
+        return pipeline;
+    }
+
+    void Vireo::addCompilationTask(std::move_only_function<void()> task, const bool priority) const {
+        auto lock = std::lock_guard{compilationMutex};
+        if (compilationThreads.empty()) {
+            // Threads are started on the first use, half of the cores are left to the application
+            const auto threadCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+            for (auto i = 0u; i < threadCount; i++) {
+                compilationThreads.emplace_back([this](const std::stop_token& stopToken) {
+                    while (true) {
+                        auto nextTask = std::move_only_function<void()>{};
+                        {
+                            auto lock = std::unique_lock{compilationMutex};
+                            if (!compilationCondition.wait(lock, stopToken, [this] {
+                                return !compilationTasks.empty();
+                            })) {
+                                return;
+                            }
+                            nextTask = std::move(compilationTasks.front());
+                            compilationTasks.pop_front();
+                            if (compilationPriorityTasks > 0) {
+                                compilationPriorityTasks -= 1;
+                            }
+                        }
+                        nextTask();
+                    }
+                });
+            }
+        }
+        if (priority) {
+            compilationTasks.insert(compilationTasks.begin() + compilationPriorityTasks, std::move(task));
+            compilationPriorityTasks += 1;
+        } else {
+            compilationTasks.push_back(std::move(task));
+        }
+        compilationCondition.notify_one();
+    }
+
+    void Vireo::stopCompilationThreads() {
+        // Pending compilations are abandoned, their futures hold a std::future_error. The queue is emptied before the
+        // stop request, else the threads would run all the pending tasks before exiting.
+        {
+            auto lock = std::lock_guard{compilationMutex};
+            compilationTasks.clear();
+            compilationPriorityTasks = 0;
+        }
+        for (auto& thread : compilationThreads) {
+            thread.request_stop();
+        }
+        // Waits for the compilations in progress
+        compilationThreads.clear();
+    }
+
+    std::shared_ptr<SwapChain> Vireo::createOffscreenSwapChain(
+        ImageFormat,
+        const std::shared_ptr<SubmitQueue>&,
+        const Extent&,
+        uint32_t) const {
+        throw Exception("Offscreen swap chains are not supported by this backend");
+    }
+
+    std::vector<std::shared_ptr<RenderTarget>> Vireo::createTransientRenderTargets(
+        const std::vector<TransientRenderTargetDesc>& descs) const {
+        // Default implementation for backends without memory aliasing
+        auto renderTargets = std::vector<std::shared_ptr<RenderTarget>>{};
+        renderTargets.reserve(descs.size());
+        for (const auto& desc : descs) {
+            assert(desc.firstUse <= desc.lastUse);
+            renderTargets.push_back(createRenderTarget(
+                desc.format,
+                desc.width,
+                desc.height,
+                desc.type,
+                desc.clearValue,
+                desc.arraySize,
+                desc.msaa,
+                desc.name));
+        }
+        return renderTargets;
+    }
+
     void Buffer::write(const void* data, const size_t size, const size_t offset) const {
         assert(mappedAddress != nullptr);
         assert(data != nullptr);
@@ -80,6 +462,35 @@ namespace vireo {
         }
     }
 
+    CommandAllocatorPool::CommandAllocatorPool(
+        const std::shared_ptr<const Vireo>& vireo,
+        const CommandType type,
+        const uint32_t framesInFlight) :
+        vireo{vireo},
+        type{type},
+        frames(framesInFlight) {
+        assert(vireo != nullptr);
+        assert(framesInFlight > 0);
+    }
+
+    std::shared_ptr<CommandAllocator> CommandAllocatorPool::get(const uint32_t frameIndex) {
+        assert(frameIndex < frames.size());
+        auto lock = std::lock_guard{mutex};
+        auto& allocator = frames[frameIndex][std::this_thread::get_id()];
+        if (allocator == nullptr) {
+            allocator = vireo->createCommandAllocator(type);
+        }
+        return allocator;
+    }
+
+    void CommandAllocatorPool::reset(const uint32_t frameIndex) {
+        assert(frameIndex < frames.size());
+        auto lock = std::lock_guard{mutex};
+        for (const auto& allocator : std::views::values(frames[frameIndex])) {
+            allocator->reset();
+        }
+    }
+
     uint32_t Image::getRowPitch(const uint32_t mipLevel) const {
         if (format >= ImageFormat::BC1_UNORM) {
             return (((width >> mipLevel) + 3) / 4) * pixelSize[static_cast<int>(format)];
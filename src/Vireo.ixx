@@ -37,6 +37,8 @@ export namespace vireo {
         DIRECTX,
         //! Vulkan 1.3
         VULKAN,
+        //! No GPU : commands are recorded in memory and submissions complete immediately, for CPU benchmarks
+        NULL_RECORDER,
     };
 
     /**
@@ -488,6 +490,8 @@ export namespace vireo {
         BlendOp         alphaBlendOp{BlendOp::ADD};
         //! Is a bitmask specifying which of the R, G, B, and/or A components are enabled for writing
         ColorWriteMask  colorWriteMask{ColorWriteMask::ALL};
+
+        bool operator==(const ColorBlendDesc&) const = default;
     };
 
     /**
@@ -508,6 +512,8 @@ export namespace vireo {
         uint32_t  compareMask{0xFFFFFFFF};
         //! Selects the bits of the unsigned integer stencil values updated by the stencil test in the stencil attachment
         uint32_t  writeMask{0xFFFFFFFF};
+
+        bool operator==(const StencilOpState&) const = default;
     };
 
 #undef DOMAIN
@@ -824,6 +830,56 @@ export namespace vireo {
         void* ref;
     };
 
+    /**
+     * Memory statistics of one memory heap.
+     * Budget and usage are process-wide values reported by the driver (VK_EXT_memory_budget with Vulkan,
+     * IDXGIAdapter3::QueryVideoMemoryInfo with DirectX) and are 0 when not available.
+     */
+    struct MemoryHeapStatistics {
+        //! Total size of the heap in bytes
+        uint64_t size{0};
+        //! `true` for device-local (VRAM) heaps
+        bool     deviceLocal{false};
+        //! Bytes of device memory allocated by the backend in this heap
+        uint64_t allocatedBytes{0};
+        //! Bytes of the allocated memory used by buffers and images
+        uint64_t usedBytes{0};
+        //! Number of device memory blocks allocated in this heap
+        uint32_t blockCount{0};
+        //! Number of buffers and images placed in this heap
+        uint32_t allocationCount{0};
+        //! Estimated bytes used by the process in this heap, as reported by the driver
+        uint64_t usage{0};
+        //! Estimated bytes the process can use in this heap without degrading performances
+        uint64_t budget{0};
+    };
+
+    /**
+     * Memory statistics of one memory type
+     */
+    struct MemoryTypeStatistics {
+        //! Index of the heap this memory type is taken from
+        uint32_t heapIndex{0};
+        //! Bytes of device memory allocated by the backend with this type
+        uint64_t allocatedBytes{0};
+        //! Bytes of the allocated memory used by buffers and images
+        uint64_t usedBytes{0};
+        //! Number of device memory blocks allocated with this type
+        uint32_t blockCount{0};
+        //! Number of buffers and images placed in memory of this type
+        uint32_t allocationCount{0};
+    };
+
+    /**
+     * Device memory statistics, per heap and per memory type
+     */
+    struct MemoryStatistics {
+        //! Statistics for each memory heap of the physical device
+        std::vector<MemoryHeapStatistics> heaps;
+        //! Statistics for each memory type of the physical device
+        std::vector<MemoryTypeStatistics> types;
+    };
+
     /**
      * A fence object. Fences are a synchronization primitive that can be used to insert a dependency from a queue to
      * the host (CPU/GPU synchronization).
@@ -1011,9 +1067,9 @@ export namespace vireo {
          * Returns the currently allocated buffers.
          * Only available if isMemoryUsageEnabled() is `true`
          */
-        static auto getMemoryAllocations() { return memoryAllocations; }
+        static std::list<VideoMemoryAllocationDesc> getMemoryAllocations();
 
-        virtual ~Buffer() = default;
+        virtual ~Buffer();
         Buffer (const Buffer&) = delete;
         Buffer& operator = (const Buffer&) = delete;
 
@@ -1026,11 +1082,15 @@ export namespace vireo {
 
         Buffer(const BufferType type): type{type} {}
 
-        static std::mutex memoryAllocationsMutex;
-        static std::list<VideoMemoryAllocationDesc> memoryAllocations;
+        // Registers the allocation, the entry is removed by the destructor
+        void addMemoryAllocation(const VideoMemoryAllocationDesc& desc);
 
     private:
         const BufferType type;
+
+        static std::mutex memoryAllocationsMutex;
+        static std::list<VideoMemoryAllocationDesc> memoryAllocations;
+        std::optional<std::list<VideoMemoryAllocationDesc>::iterator> memoryAllocation;
     };
 
     /**
@@ -1152,6 +1212,11 @@ export namespace vireo {
          */
         static constexpr uint32_t ALL_LAYERS{0};
 
+        /**
+         * Specify all mip levels for barriers
+         */
+        static constexpr uint32_t ALL_MIP_LEVELS{0};
+
         /**
          * Returns the pixel format
          */
@@ -1231,7 +1296,7 @@ export namespace vireo {
          * Returns the currently allocated images.
          * Only available if isMemoryUsageEnabled() is `true`
          */
-        static auto getMemoryAllocations() { return memoryAllocations; }
+        static std::list<VideoMemoryAllocationDesc> getMemoryAllocations();
 
         /** Returns `true` if the given format is a depth-only format. */
         static bool isDepthFormat(ImageFormat format);
@@ -1252,7 +1317,7 @@ export namespace vireo {
         /** Returns the debug name assigned to this image. */
         const auto& getName() const { return name; }
 
-        virtual ~Image() = default;
+        virtual ~Image();
         Image (Image&) = delete;
         Image& operator = (const Image&) = delete;
 
@@ -1273,10 +1338,14 @@ export namespace vireo {
             arraySize{arraySize},
             readWrite{isReadWrite} {}
 
+        // Registers the allocation, the entry is removed by the destructor
+        void addMemoryAllocation(const VideoMemoryAllocationDesc& desc);
+
+    private:
         static std::mutex memoryAllocationsMutex;
         static std::list<VideoMemoryAllocationDesc> memoryAllocations;
+        std::optional<std::list<VideoMemoryAllocationDesc>::iterator> memoryAllocation;
 
-    private:
         const std::string name;
         const ImageFormat format;
         const uint32_t    width;
@@ -1328,6 +1397,38 @@ export namespace vireo {
         const std::shared_ptr<Image> image;
     };
 
+    /**
+     * Description of a transient render target, used only during a part of a frame.
+     * Transient render targets whose lifetimes never overlap share the same memory.
+     *
+     * Manual page : \ref manual_030_02_resources
+     */
+    struct TransientRenderTargetDesc {
+        //! Pixel format
+        ImageFormat      format;
+        //! Width in pixels
+        uint32_t         width;
+        //! Height in pixels
+        uint32_t         height;
+        //! Type of render target use
+        RenderTargetType type{RenderTargetType::COLOR};
+        //! Index of the first pass using the render target
+        uint32_t         firstUse{0};
+        //! Index of the last pass using the render target (inclusive)
+        uint32_t         lastUse{0};
+        //! A clear value used for optimized clearing
+        ClearValue       clearValue{};
+        //! Number of layers of the image
+        uint32_t         arraySize{1};
+        //! Number of samples for MSAA
+        MSAA             msaa{MSAA::NONE};
+        //! `true` if the content is only accessed as an attachment inside a render pass and never sampled or copied
+        //! (MSAA color or depth buffers resolved in the same pass). Allows lazily allocated memory on tiled GPUs.
+        bool             attachmentOnly{false};
+        //! Object name for debug
+        std::string      name{"TransientRenderTarget"};
+    };
+
     /**
      * A descriptor set layout object.
      * Describes resources that shaders can use.
@@ -1375,6 +1476,14 @@ export namespace vireo {
          */
         auto isBindless() const { return bindless; }
 
+        /**
+         * Returns the type of resource of a binding, or `std::nullopt` if the binding has not been added
+         */
+        std::optional<DescriptorType> getType(const DescriptorIndex index) const {
+            const auto it = types.find(index);
+            return it == types.end() ? std::nullopt : std::optional{it->second};
+        }
+
         virtual ~DescriptorLayout() = default;
         DescriptorLayout (DescriptorLayout&) = delete;
         DescriptorLayout& operator = (const DescriptorLayout&) = delete;
@@ -1388,11 +1497,28 @@ export namespace vireo {
         bool   dynamic{false};
         // true for bindless descriptor indexing
         bool   bindless{false};
+        // Type of resource of each binding, recorded by add()
+        std::map<DescriptorIndex, DescriptorType> types;
 
         DescriptorLayout(const bool samplers, const bool dynamic, const bool bindless = false)
             : samplers{samplers}, dynamic{dynamic}, bindless{bindless} {}
     };
 
+    /**
+     * A resource written in a descriptor set by DescriptorSet::update(const std::vector<DescriptorWrite>&)
+     */
+    struct DescriptorWrite {
+        //! Binding index
+        DescriptorIndex index;
+        //! Buffer, image or sampler written at the binding index
+        std::variant<
+            std::shared_ptr<const Buffer>,
+            std::shared_ptr<const Image>,
+            std::shared_ptr<const Sampler>> resource;
+        //! Element of the binding array
+        uint32_t arrayElement{0};
+    };
+
     /**
      * A descriptor set object.
      * Contains resources for the shaders.
@@ -1493,6 +1619,14 @@ export namespace vireo {
          */
         virtual void update(DescriptorIndex index, const std::vector<std::shared_ptr<Sampler>>& samplers) = 0;
 
+        /**
+         * Bind several resources with one backend call. With Vulkan, when the writes cover all the bindings of a
+         * non-bindless set, the whole set is written with a descriptor update template.
+         * Buffers are bound with their whole size, except for dynamic uniform sets.
+         * @param writes The resources and their binding indices
+         */
+        virtual void update(const std::vector<DescriptorWrite>& writes) = 0;
+
         /** Returns the descriptor layout this set was created from. */
         const auto& getLayout() const { return layout; }
 
@@ -1506,6 +1640,39 @@ export namespace vireo {
         DescriptorSet(const std::shared_ptr<const DescriptorLayout>& layout) : layout{layout} {}
     };
 
+    /**
+     * Linear allocator for the descriptor sets used during a single frame.
+     * All the descriptor sets created since the last reset are released together by reset().
+     *
+     * @warning Not thread-safe, use one allocator per thread and per frame in flight.
+     *
+     * Manual page : \ref manual_040_02_descriptor_set
+     */
+    class TransientDescriptorAllocator : public std::enable_shared_from_this<TransientDescriptorAllocator> {
+    public:
+        /**
+         * Creates a descriptor set valid until the next reset(). Bindless layouts are not supported.
+         * @param layout Layout of the set
+         * @param name Object name for debug
+         */
+        virtual std::shared_ptr<DescriptorSet> createDescriptorSet(
+            const std::shared_ptr<const DescriptorLayout>& layout,
+            const std::string& name = "TransientDescriptorSet") = 0;
+
+        /**
+         * Releases all the descriptor sets created since the last reset.
+         * Must be called once the commands using them are finished, usually after waiting for the frame fence.
+         */
+        virtual void reset() = 0;
+
+        virtual ~TransientDescriptorAllocator() = default;
+        TransientDescriptorAllocator (TransientDescriptorAllocator&) = delete;
+        TransientDescriptorAllocator& operator = (const TransientDescriptorAllocator&) = delete;
+
+    protected:
+        TransientDescriptorAllocator() = default;
+    };
+
     /**
      * An input vertex layout
      *
@@ -1535,6 +1702,73 @@ export namespace vireo {
         ShaderModule() = default;
     };
 
+    /**
+     * A set of shader modules loaded from a single shader pack file with Vireo::loadShaderPack.
+     *
+     * A shader pack file contains a header, a table of contents sorted by the hash of the shaders names,
+     * the names and the compiled shaders, 16 bytes aligned.
+     *
+     * Manual page : \ref manual_070_00_shaders
+     */
+    class ShaderPack : public std::enable_shared_from_this<ShaderPack> {
+    public:
+        //! Extension added after the backend shader extension to the shader pack file names
+        static constexpr auto FILE_EXTENSION = ".pack";
+
+        /**
+         * Returns the shader module named `name`, throws an Exception if the pack does not contain it
+         */
+        std::shared_ptr<ShaderModule> get(const std::string& name) const;
+
+        /**
+         * Returns `true` if the pack contains a shader module named `name`
+         */
+        bool contains(const std::string& name) const { return find(name).has_value(); }
+
+        /**
+         * Returns the number of shader modules in the pack
+         */
+        auto getSize() const { return modules.size(); }
+
+        /**
+         * Writes a shader pack file. Throws an Exception if a shader is empty or if the file can't be written.
+         * @param fileName File name, with the extensions
+         * @param shaders Names and compiled code (SPIR-V or DXIL) of the shaders
+         */
+        static void write(const std::string& fileName, const std::vector<std::pair<std::string, std::vector<char>>>& shaders);
+
+    private:
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t reserved;
+        };
+
+        struct Entry {
+            uint64_t nameHash;
+            uint32_t nameOffset;
+            uint32_t nameSize;
+            uint64_t codeOffset;
+            uint64_t codeSize;
+        };
+
+        static constexpr uint32_t MAGIC{0x50535256}; // "VRSP"
+        static constexpr uint32_t VERSION{1};
+        static constexpr uint64_t CODE_ALIGNMENT{16};
+
+        // Sorted by hash, like the table of contents
+        std::vector<uint64_t>                      hashes;
+        std::vector<std::string>                   names;
+        std::vector<std::shared_ptr<ShaderModule>> modules;
+
+        std::optional<size_t> find(const std::string& name) const;
+
+        static uint64_t hash(const std::string& name);
+
+        friend class Vireo;
+    };
+
     /**
      * All resources used by the shaders of a pipeline : descriptor layouts & push constants
      *
@@ -1605,6 +1839,48 @@ export namespace vireo {
             Pipeline{PipelineType::GRAPHIC, pipelineResources} {}
     };
 
+    /**
+     * A pipeline compiled in background by Vireo::createGraphicPipelineAsync or Vireo::createComputePipelineAsync.
+     * Copies share the same compilation.
+     *
+     * Manual page : \ref manual_080_00_pipelines
+     */
+    template <typename T>
+    class AsyncPipeline {
+    public:
+        AsyncPipeline(
+            const std::shared_future<std::shared_ptr<T>>& future,
+            const std::shared_ptr<T>& fallback) :
+            future{future},
+            fallback{fallback} {}
+
+        /**
+         * Returns `true` if the compilation is finished
+         */
+        bool isReady() const {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        /**
+         * Returns the compiled pipeline, or the fallback pipeline (can be `nullptr`) if the compilation is not finished.
+         * Rethrows the exception thrown by the compilation, if any.
+         */
+        std::shared_ptr<T> get() const {
+            return isReady() ? future.get() : fallback;
+        }
+
+        /**
+         * Blocks the calling thread until the compilation is finished and returns the compiled pipeline
+         */
+        std::shared_ptr<T> wait() const {
+            return future.get();
+        }
+
+    private:
+        std::shared_future<std::shared_ptr<T>> future;
+        std::shared_ptr<T>                     fallback;
+    };
+
     class SwapChain;
 
     /**
@@ -1649,6 +1925,8 @@ export namespace vireo {
         ClearValue                     depthStencilClearValue{ .depthStencil = {1.0f, 0} };
         //! Discard the content of the depth and stencil attachment after rendering
         bool                           discardDepthStencilAfterRender{false};
+        //! The draw commands are recorded in secondary command lists executed with CommandList::executeCommands
+        bool                           secondaryCommandLists{false};
     };
 
     /**
@@ -1716,6 +1994,7 @@ export namespace vireo {
 
     /**
      * A GPU timestamp query pool, used for GPU-side performance profiling.
+     * See GPUProfiler for named scopes with a delayed readback.
      */
     class QueryPool : public std::enable_shared_from_this<QueryPool> {
     public:
@@ -1754,10 +2033,149 @@ export namespace vireo {
         double   timestampPeriodMs;
     };
 
+    /**
+     * A set of memory barriers recorded together with CommandList::barrier(const BarrierBatch&).
+     * Accumulate the image, buffer and global barriers of a pass boundary then record them with a single command.
+     *
+     * Manual page : \ref manual_090_03_barriers
+     */
+    class BarrierBatch {
+    public:
+        /**
+         * Image state transition. One of `image` or `swapChain` is set.
+         */
+        struct ImageBarrier {
+            //! The image, `nullptr` for the current image of a swap chain
+            std::shared_ptr<const Image>     image;
+            //! The swap chain, `nullptr` for an image
+            std::shared_ptr<const SwapChain> swapChain;
+            //! Old state
+            ResourceState                    oldState;
+            //! New state
+            ResourceState                    newState;
+            //! First mip level
+            uint32_t                         firstMipLevel;
+            //! Number of mip levels, or Image::ALL_MIP_LEVELS
+            uint32_t                         levelCount;
+            //! First array layer
+            uint32_t                         firstArrayLayer;
+            //! Number of array layers, or Image::ALL_LAYERS
+            uint32_t                         layerCount;
+        };
+
+        /**
+         * Buffer state transition
+         */
+        struct BufferBarrier {
+            //! The buffer
+            std::shared_ptr<const Buffer> buffer;
+            //! Old state
+            ResourceState                 oldState;
+            //! New state
+            ResourceState                 newState;
+        };
+
+        /**
+         * Global memory dependency, for all resources
+         */
+        struct MemoryBarrier {
+            //! Old state
+            ResourceState oldState;
+            //! New state
+            ResourceState newState;
+        };
+
+        /**
+         * Adds an image state transition for a range of mip levels and layers
+         */
+        BarrierBatch& add(
+            const std::shared_ptr<const Image>& image,
+            const ResourceState oldState,
+            const ResourceState newState,
+            const uint32_t firstMipLevel = 0,
+            const uint32_t levelCount = Image::ALL_MIP_LEVELS,
+            const uint32_t firstArrayLayer = 0,
+            const uint32_t layerCount = Image::ALL_LAYERS) {
+            imageBarriers.push_back({image, nullptr, oldState, newState, firstMipLevel, levelCount, firstArrayLayer, layerCount});
+            return *this;
+        }
+
+        /**
+         * Adds a state transition of the image of a render target
+         */
+        BarrierBatch& add(
+            const std::shared_ptr<const RenderTarget>& renderTarget,
+            const ResourceState oldState,
+            const ResourceState newState,
+            const uint32_t firstArrayLayer = 0,
+            const uint32_t layerCount = Image::ALL_LAYERS) {
+            return add(renderTarget->getImage(), oldState, newState, 0, Image::ALL_MIP_LEVELS, firstArrayLayer, layerCount);
+        }
+
+        /**
+         * Adds a state transition of the current image of a swap chain
+         */
+        BarrierBatch& add(
+            const std::shared_ptr<const SwapChain>& swapChain,
+            const ResourceState oldState,
+            const ResourceState newState) {
+            imageBarriers.push_back({nullptr, swapChain, oldState, newState, 0, 1, 0, Image::ALL_LAYERS});
+            return *this;
+        }
+
+        /**
+         * Adds a buffer state transition
+         */
+        BarrierBatch& add(
+            const std::shared_ptr<const Buffer>& buffer,
+            const ResourceState oldState,
+            const ResourceState newState) {
+            bufferBarriers.push_back({buffer, oldState, newState});
+            return *this;
+        }
+
+        /**
+         * Adds a global memory dependency between two states, for all the resources
+         */
+        BarrierBatch& add(const ResourceState oldState, const ResourceState newState) {
+            memoryBarriers.push_back({oldState, newState});
+            return *this;
+        }
+
+        /**
+         * Returns `true` if the batch contains no barrier
+         */
+        bool empty() const { return imageBarriers.empty() && bufferBarriers.empty() && memoryBarriers.empty(); }
+
+        /**
+         * Removes all the barriers, keeping the memory for the next batch
+         */
+        void clear() {
+            imageBarriers.clear();
+            bufferBarriers.clear();
+            memoryBarriers.clear();
+        }
+
+        /** Returns the image barriers */
+        const auto& getImageBarriers() const { return imageBarriers; }
+
+        /** Returns the buffer barriers */
+        const auto& getBufferBarriers() const { return bufferBarriers; }
+
+        /** Returns the global memory barriers */
+        const auto& getMemoryBarriers() const { return memoryBarriers; }
+
+    private:
+        std::vector<ImageBarrier>  imageBarriers;
+        std::vector<BufferBarrier> bufferBarriers;
+        std::vector<MemoryBarrier> memoryBarriers;
+    };
+
     /**
      * A command list (buffer) object
      *
-     * @warning Not thread-safe. Must be recorded from a single thread.
+     * @warning Not thread-safe. Must be recorded from a single thread. To record in parallel, use one
+     *       CommandAllocator per thread (see CommandAllocatorPool) and secondary command lists.
      * @note Lifecycle: call `begin()` before recording, `end()` after, then `cleanup()`
      *       once the GPU has finished executing the submission.
      * @note Lifetime: any Pipeline or DescriptorSet bound during recording must remain
@@ -1778,11 +2196,27 @@ export namespace vireo {
          */
         virtual void begin() const = 0;
 
+        /**
+         * Start recording a secondary command list executed inside the render pass started by
+         * `primary.beginRendering()`. The attachments formats are inherited from the primary command list, which
+         * must have been started with RenderingConfiguration::secondaryCommandLists.
+         * The pipeline and descriptors are not inherited and must be bound again. For portability, set the viewports
+         * and scissors in the secondary command list and in the primary command list before executeCommands().
+         * @param primary The primary command list, inside a beginRendering()/endRendering() block
+         */
+        virtual void begin(const CommandList& primary) const = 0;
+
         /**
          * Stop recording a command list
          */
         virtual void end() const = 0;
 
+        /**
+         * Executes secondary command lists. The secondary command lists must be ended before this call.
+         * @param commandLists Secondary command lists created with CommandAllocator::createSecondaryCommandList
+         */
+        virtual void executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const = 0;
+
         /**
          * Uploads data into a buffer using a temporary (staging) buffer.
          */
@@ -2119,6 +2553,23 @@ export namespace vireo {
             bindPipeline(*pipeline, descriptorsAlreadyBounds);
         }
 
+        /**
+         * Binds a pipeline compiled in background, or its fallback pipeline if the compilation is not finished
+         * @return `false` if the pipeline is not ready and have no fallback : nothing is bound and
+         * the draw calls using this pipeline must be skipped
+         */
+        template <typename T>
+        bool bindPipeline(
+            const AsyncPipeline<T>& pipeline,
+            const bool descriptorsAlreadyBounds = false) {
+            const auto readyPipeline = pipeline.get();
+            if (readyPipeline == nullptr) {
+                return false;
+            }
+            bindPipeline(*readyPipeline, descriptorsAlreadyBounds);
+            return true;
+        }
+
         /**
          * Bind descriptor sets to a command list, before binding a pipeline
          * @param pipelineType The pipelines type to be bound after
@@ -2445,15 +2896,41 @@ export namespace vireo {
             ResourceState newState) const = 0;
 
         /**
-         * Records a GPU timestamp into a query pool slot at the top-of-pipe stage.
+         * Records all the barriers of a batch with a single command
+         * @param batch The barriers. The batch can be cleared and reused after the call.
+         */
+        virtual void barrier(const BarrierBatch& batch) const = 0;
+
+        /**
+         * Resets a contiguous range of timestamp slots, before writing them again.
+         * Reset all the slots of a frame with one call instead of one call per slot.
+         *
+         * @param queryPool   The pool to reset.
+         * @param firstQuery  Index of the first slot to reset.
+         * @param queryCount  Number of consecutive slots to reset.
+         *
+         * @note Must be recorded outside of a rendering pass (between endRendering() and beginRendering()).
+         *       This is a no-op with DirectX.
+         */
+        virtual void resetQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) = 0;
+
+        /**
+         * Records a GPU timestamp into a query pool slot.
          *
          * @param queryPool The pool to write into.
          * @param queryIndex Slot index within the pool (must be < pool capacity).
+         * @param stage Stage the timestamp is written at : the timestamp of the end of a work waits for the previous
+         *        commands with WaitStage::ALL_COMMANDS. Ignored with DirectX, the timestamps are written when the
+         *        previous commands are complete.
          *
+         * @note The slot must have been reset with resetQueryPool() since its last write.
          * @note Always call resolveQueryPool() after all writeTimestamp() calls
          *       in the same command list, before the list is submitted.
          */
-        virtual void writeTimestamp(const QueryPool& queryPool, uint32_t queryIndex) = 0;
+        virtual void writeTimestamp(
+            const QueryPool& queryPool,
+            uint32_t queryIndex,
+            WaitStage stage = WaitStage::PIPELINE_TOP) = 0;
 
         /**
          * Copies a contiguous range of timestamp slots from a query pool into its
@@ -2516,6 +2993,12 @@ export namespace vireo {
          */
         virtual std::shared_ptr<CommandList> createCommandList() const  = 0;
 
+        /**
+         * Returns a new secondary command list, executed by a primary command list with CommandList::executeCommands.
+         * Only available for CommandType::GRAPHIC allocators.
+         */
+        virtual std::shared_ptr<CommandList> createSecondaryCommandList() const = 0;
+
         /**
          * Returns the type of command list created by this allocator
          */
@@ -2532,6 +3015,48 @@ export namespace vireo {
         const CommandType commandListType;
     };
 
+    class Vireo;
+
+    /**
+     * Per-thread command allocators for each frame in flight.
+     * Each recording thread gets its own CommandAllocator for a given frame, created on first use,
+     * so threads can record command lists in parallel without sharing an allocator.
+     *
+     * Manual page : \ref manual_050_00_commands
+     */
+    class CommandAllocatorPool {
+    public:
+        /**
+         * Creates an empty pool
+         * @param vireo Vireo instance used to create the allocators
+         * @param type Type of the allocators
+         * @param framesInFlight Number of frames in flight
+         */
+        CommandAllocatorPool(const std::shared_ptr<const Vireo>& vireo, CommandType type, uint32_t framesInFlight);
+
+        /**
+         * Returns the command allocator of the calling thread for a frame. Thread-safe.
+         * @param frameIndex Index of the frame in flight
+         */
+        std::shared_ptr<CommandAllocator> get(uint32_t frameIndex);
+
+        /**
+         * Resets all the command allocators of a frame, once the GPU has finished executing the frame
+         * and before the threads record the next one.
+         * @param frameIndex Index of the frame in flight
+         */
+        void reset(uint32_t frameIndex);
+
+        CommandAllocatorPool(CommandAllocatorPool&) = delete;
+        CommandAllocatorPool& operator = (const CommandAllocatorPool&) = delete;
+
+    private:
+        const std::shared_ptr<const Vireo> vireo;
+        const CommandType                  type;
+        std::mutex                         mutex;
+        std::vector<std::unordered_map<std::thread::id, std::shared_ptr<CommandAllocator>>> frames;
+    };
+
     /**
      * Command submission queue. Thread-safe: all submit() and waitIdle() calls
      * are serialized by an internal recursive mutex.
@@ -2672,6 +3197,20 @@ export namespace vireo {
          */
         virtual void waitIdle() const = 0;
 
+        /**
+         * Enables or disables the deferred mode. In deferred mode the submit() calls are recorded and issued together
+         * by flush(), with one driver call per fence instead of one per submit(). Disabling the deferred mode flushes
+         * the recorded submissions.
+         * @note Call flush() before waiting for a fence of a deferred submission and before presenting a swap chain
+         * with another queue. The submissions are always immediate with the DirectX backend.
+         */
+        virtual void setDeferred(bool deferred) = 0;
+
+        /**
+         * Issues the submissions recorded in deferred mode
+         */
+        virtual void flush() const = 0;
+
         std::recursive_mutex& getMutex() { return submitMutex; }
 
         virtual ~SubmitQueue() = default;
@@ -2741,6 +3280,14 @@ export namespace vireo {
          */
         virtual void waitIdle() = 0;
 
+        /**
+         * Offscreen swap chains only : waits for the copy of the last presented frame buffer in host memory and
+         * returns the address of its pixels, in rows of `getExtent().width` pixels without padding.
+         * The pixels are valid until the same frame buffer is presented again.
+         * @return `nullptr` for window swap chains or if no frame buffer have been presented
+         */
+        virtual const void* readback() const { return nullptr; }
+
         virtual ~SwapChain() = default;
         SwapChain (SwapChain&) = delete;
         SwapChain& operator = (const SwapChain&) = delete;
@@ -2830,6 +3377,9 @@ export namespace vireo {
 
         //! Controls whether a temporary coverage value is generated based on the alpha component of the fragment’s first color output
         bool              alphaToCoverageEnable{false};
+
+        //! Shaders, resources and vertex layouts are compared by identity
+        bool operator==(const GraphicPipelineConfiguration&) const = default;
     };
 
     /**
@@ -2859,6 +3409,12 @@ export namespace vireo {
         DebugCallback debugCallback = nullptr;
         //! Vulkan validation layer messages whose text contains any of these substrings will be silently filtered
         std::vector<const char*> vulkanFilteredValidationMessages = { };
+        //! Use VK_EXT_descriptor_buffer when supported by the device : descriptor sets are ranges of a GPU visible buffer,
+        //! written with memory copies and bound by offset, without descriptor pools
+        bool vulkanDescriptorBuffer = false;
+        //! No window system : the Vulkan surface and swap chain extensions are not required and only offscreen swap
+        //! chains, created with Vireo::createOffscreenSwapChain, can be used
+        bool headless = false;
         //! Maximum number of CBV/SRV/UAV descriptors in the DirectX 12 global heap
         uint32_t directX12MaxDescriptors = 3000;
         //! Maximum number of sampler descriptors in the DirectX 12 global sampler heap
@@ -2895,6 +3451,20 @@ export namespace vireo {
             PresentMode presentMode = PresentMode::VSYNC,
             uint32_t framesInFlight = 2) const = 0;
 
+        /**
+         * Creates a swap chain without window, backed by a ring of render targets. Presenting copies the current frame
+         * buffer in host memory, available with SwapChain::readback(). Supported by the Vulkan backend only.
+         * @param format            Color format of the frame buffers
+         * @param presentQueue      Queue used to copy the frame buffers in host memory
+         * @param extent            Size of the frame buffers
+         * @param framesInFlight    Number of frame buffers
+         */
+        virtual std::shared_ptr<SwapChain> createOffscreenSwapChain(
+            ImageFormat format,
+            const std::shared_ptr<SubmitQueue>& presentQueue,
+            const Extent& extent,
+            uint32_t framesInFlight = 2) const;
+
         /**
          * Creates a submission queue
          * @param commandType Type of commands that will be used with this queue.
@@ -2940,7 +3510,7 @@ export namespace vireo {
         /**
          * Load a compiled shader and creates a shader module
          * @param fileName File name without the extension. The file name extension must be `.spv`for Vulkan et `.dxil`
-         * for DirectX
+         * for DirectX. With Vulkan the file is memory mapped and given to the driver without copy.
          */
         virtual std::shared_ptr<ShaderModule> createShaderModule(
             const std::string& fileName) const = 0;
@@ -2961,6 +3531,24 @@ export namespace vireo {
             const std::vector<char>& data,
             const std::string& name) const = 0;
 
+        /**
+         * Creates a shader module from a compiled shader binary in memory, without copying it.
+         * Used for shaders embedded in the executable or in memory mapped files.
+         * @param code Compiled shader bytecode (SPIR-V for Vulkan, DXIL for DirectX), 4 bytes aligned
+         * @param name Object name for debug tools.
+         */
+        virtual std::shared_ptr<ShaderModule> createShaderModule(
+            std::span<const uint32_t> code,
+            const std::string& name) const = 0;
+
+        /**
+         * Loads a shader pack file and creates all its shader modules, in parallel on the pipeline compilation
+         * threads. The modules are created before the queued background pipeline compilations.
+         * @param fileName File name without the extensions. The file name extension must be `.spv.pack` for Vulkan and
+         * `.dxil.pack` for DirectX
+         */
+        std::shared_ptr<ShaderPack> loadShaderPack(const std::string& fileName) const;
+
         /**
          * Creates a pipeline resources description. Describe resources that can be accessed by
          * the shaders associated with the future pipelines.
@@ -2993,6 +3581,41 @@ export namespace vireo {
             const GraphicPipelineConfiguration& configuration,
             const std::string& name = "GraphicPipeline") const = 0;
 
+        /**
+         * Creates a compute pipeline in a background thread, without blocking the calling thread
+         * @param pipelineResources Resources for the shader
+         * @param shader The shader
+         * @param fallback Pipeline used by CommandList::bindPipeline until the compilation is finished. Can be `nullptr`
+         * @param name Object name for debug
+         */
+        AsyncPipeline<ComputePipeline> createComputePipelineAsync(
+            const std::shared_ptr<PipelineResources>& pipelineResources,
+            const std::shared_ptr<const ShaderModule>& shader,
+            const std::shared_ptr<ComputePipeline>& fallback = nullptr,
+            const std::string& name = "ComputePipeline") const;
+
+        /**
+         * Creates a graphic pipeline in a background thread, without blocking the calling thread
+         * @param configuration Pipeline configuration
+         * @param fallback Pipeline used by CommandList::bindPipeline until the compilation is finished. Can be `nullptr`
+         * @param name Object name for debug
+         */
+        AsyncPipeline<GraphicPipeline> createGraphicPipelineAsync(
+            const GraphicPipelineConfiguration& configuration,
+            const std::shared_ptr<GraphicPipeline>& fallback = nullptr,
+            const std::string& name = "GraphicPipeline") const;
+
+        /**
+         * Returns a graphic pipeline shared by all the callers using an identical configuration, the pipeline is
+         * created on the first call. Shaders, resources and vertex layouts are compared by identity.
+         * The registry only keeps weak references, a pipeline is destroyed when no caller use it.
+         * @param configuration Pipeline configuration
+         * @param name Object name for debug, used if the pipeline is created
+         */
+        std::shared_ptr<GraphicPipeline> getGraphicPipeline(
+            const GraphicPipelineConfiguration& configuration,
+            const std::string& name = "GraphicPipeline") const;
+
         /**
          * Creates a data buffer in VRAM.
          * For types UNIFORM & TRANSFER the buffer will be created in host visible memory/upload heap type.
@@ -3087,6 +3710,17 @@ export namespace vireo {
         virtual std::shared_ptr<RenderTarget> createRenderTarget(
             const std::shared_ptr<Image>& image) const = 0;
 
+        /**
+         * Creates a set of transient render targets.
+         * Render targets whose `[firstUse, lastUse]` intervals never overlap are aliased on the same device memory :
+         * their content is undefined at the start of their first use and they must be transitioned from
+         * ResourceState::UNDEFINED each time they are used.
+         * @param descs Description of the render targets
+         * @return The render targets, in the same order as `descs`
+         */
+        virtual std::vector<std::shared_ptr<RenderTarget>> createTransientRenderTargets(
+            const std::vector<TransientRenderTargetDesc>& descs) const;
+
         /**
          * Creates an empty description layout.
          * @param name Object name for debug
@@ -3125,6 +3759,13 @@ export namespace vireo {
             const std::shared_ptr<const DescriptorLayout>& layout,
             const std::string& name = "DescriptorSet") const = 0;
 
+        /**
+         * Creates a linear allocator for descriptor sets used during one frame
+         * @param name Object name for debug
+         */
+        virtual std::shared_ptr<TransientDescriptorAllocator> createTransientDescriptorAllocator(
+            const std::string& name = "TransientDescriptorAllocator") const = 0;
+
         /**
          * Creates a GPU timestamp query pool for performance profiling.
          * @param capacity  Maximum number of timestamp slots.
@@ -3175,6 +3816,28 @@ export namespace vireo {
          */
         virtual Backend getBackend() const = 0;
 
+        /**
+         * Loads the pipeline cache from a file written by savePipelineCache(), to avoid recompiling the pipelines
+         * at each launch. Call it before creating the pipelines.
+         * The file is ignored if it was written by another device or driver version.
+         * @param fileName Cache file name
+         * @return `false` if the file does not exist, is not valid for the current device or if the backend does not
+         * support pipeline caches
+         */
+        virtual bool loadPipelineCache(const std::string& fileName) { return false; }
+
+        /**
+         * Writes the pipeline cache, with all the pipelines created since the start, in a file
+         * @param fileName Cache file name
+         */
+        virtual void savePipelineCache(const std::string& fileName) const {}
+
+        /**
+         * Returns the device memory statistics, per heap and per memory type.
+         * The counters are read without locking and can be called from any thread.
+         */
+        virtual MemoryStatistics getMemoryStatistics() const = 0;
+
         /**
          * Returns the physical device/adapter object
          */
@@ -3203,6 +3866,35 @@ export namespace vireo {
         virtual std::shared_ptr<DescriptorLayout> _createDynamicUniformDescriptorLayout(
             const std::string& name = "DynamicUniformDescriptorLayout") const = 0;
 
+        // Stops the pipeline compilation threads. Must be called by the backends destructors, the pending
+        // compilations use the device.
+        void stopCompilationThreads();
+
+    private:
+        mutable std::mutex                                      compilationMutex;
+        mutable std::condition_variable_any                     compilationCondition;
+        mutable std::deque<std::move_only_function<void()>>     compilationTasks;
+        // Number of priority tasks at the front of compilationTasks
+        mutable size_t                                          compilationPriorityTasks{0};
+        mutable std::vector<std::jthread>                       compilationThreads;
+
+        // Priority tasks are run before the other pending tasks, in the order they are added
+        void addCompilationTask(std::move_only_function<void()> task, bool priority = false) const;
+
+        // The configuration keeps the shaders alive : their addresses, used as identity, can not be reused
+        struct RegisteredPipeline {
+            GraphicPipelineConfiguration   configuration;
+            std::weak_ptr<GraphicPipeline> pipeline;
+        };
+
+        // Pipelines shared by getGraphicPipeline(), by configuration hash
+        mutable std::mutex                                            pipelinesMutex;
+        mutable std::unordered_multimap<size_t, RegisteredPipeline>   pipelines;
+        // Registry size triggering the removal of the expired pipelines
+        mutable size_t                                                pipelinesSweepSize{64};
+
+        static size_t hash(const GraphicPipelineConfiguration& configuration);
+
     };
 
 }
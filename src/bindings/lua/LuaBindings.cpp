@@ -27,6 +27,7 @@ namespace vireo {
             .addVariable("UNDEFINED", Backend::UNDEFINED)
             .addVariable("DIRECTX",   Backend::DIRECTX)
             .addVariable("VULKAN",    Backend::VULKAN)
+            .addVariable("NULL_RECORDER", Backend::NULL_RECORDER)
         .endNamespace()
         .beginNamespace("Filter")
             .addVariable("NEAREST", Filter::NEAREST)
@@ -428,6 +429,7 @@ namespace vireo {
             .addProperty("clear_depth_stencil",                       &RenderingConfiguration::clearDepthStencil)
             .addProperty("depth_stencil_clear_value",                 &RenderingConfiguration::depthStencilClearValue)
             .addProperty("discard_depth_stencil_after_render",        &RenderingConfiguration::discardDepthStencilAfterRender)
+            .addProperty("secondary_command_lists",                   &RenderingConfiguration::secondaryCommandLists)
         .endClass()
         .beginClass<DrawIndirectCommand>("DrawIndirectCommand")
             .addConstructor<void(*)()>()
@@ -576,10 +578,19 @@ namespace vireo {
                 })
             .addProperty("layout", &DescriptorSet::getLayout)
         .endClass()
+        .beginClass<TransientDescriptorAllocator>("TransientDescriptorAllocator")
+            .addFunction("create_descriptor_set", &TransientDescriptorAllocator::createDescriptorSet)
+            .addFunction("reset",                 &TransientDescriptorAllocator::reset)
+        .endClass()
         .beginClass<VertexInputLayout>("VertexInputLayout")
         .endClass()
         .beginClass<ShaderModule>("ShaderModule")
         .endClass()
+        .beginClass<ShaderPack>("ShaderPack")
+            .addFunction("get",      &ShaderPack::get)
+            .addFunction("contains", &ShaderPack::contains)
+            .addProperty("size",     &ShaderPack::getSize)
+        .endClass()
         .beginClass<PipelineResources>("PipelineResources")
         .endClass()
         .beginClass<Pipeline>("Pipeline")
@@ -603,8 +614,12 @@ namespace vireo {
             .addFunction("wait_idle",               &SwapChain::waitIdle)
         .endClass()
         .beginClass<CommandList>("CommandList")
-            .addFunction("begin", &CommandList::begin)
+            .addFunction("begin",
+                (void (CommandList::*)() const) &CommandList::begin)
+            .addFunction("begin_secondary",
+                (void (CommandList::*)(const CommandList&) const) &CommandList::begin)
             .addFunction("end",   &CommandList::end)
+            .addFunction("execute_commands", &CommandList::executeCommands)
             .addFunction("upload_buffer",
                 (void (CommandList::*)(const Buffer&, const void*)) &CommandList::upload)
             .addFunction("upload_image",
@@ -707,6 +722,8 @@ namespace vireo {
                     +[](const CommandAllocator* self, const Pipeline& pipeline) {
                         return self->createCommandList(pipeline);
                     }))
+            .addFunction("create_secondary_command_list",
+                &CommandAllocator::createSecondaryCommandList)
             .addProperty("command_list_type", &CommandAllocator::getCommandListType)
         .endClass()
         .beginClass<SubmitQueue>("SubmitQueue")
@@ -761,11 +778,14 @@ namespace vireo {
                     self->submit(signalStage, signalSemaphore, cls);
                 })
             .addFunction("wait_idle", &SubmitQueue::waitIdle)
+            .addFunction("set_deferred", &SubmitQueue::setDeferred)
+            .addFunction("flush", &SubmitQueue::flush)
         .endClass()
         .beginClass<Vireo>("Vireo")
             .addProperty("backend",   &Vireo::getBackend)
             .addFunction("wait_idle", &Vireo::waitIdle)
             .addFunction("create_swap_chain",       &Vireo::createSwapChain)
+            .addFunction("create_offscreen_swap_chain", &Vireo::createOffscreenSwapChain)
             .addFunction("create_submit_queue",     &Vireo::createSubmitQueue)
             .addFunction("create_fence",            &Vireo::createFence)
             .addFunction("create_semaphore",        &Vireo::createSemaphore)
@@ -775,9 +795,13 @@ namespace vireo {
                 (std::shared_ptr<ShaderModule> (Vireo::*)(const std::string&) const) &Vireo::createShaderModule)
             .addFunction("create_shader_module_from_data",
                 (std::shared_ptr<ShaderModule> (Vireo::*)(const std::vector<char>&, const std::string&) const) &Vireo::createShaderModule)
+            .addFunction("load_shader_pack",           &Vireo::loadShaderPack)
             .addFunction("create_pipeline_resources",  &Vireo::createPipelineResources)
             .addFunction("create_compute_pipeline",    &Vireo::createComputePipeline)
             .addFunction("create_graphic_pipeline",    &Vireo::createGraphicPipeline)
+            .addFunction("get_graphic_pipeline",       &Vireo::getGraphicPipeline)
+            .addFunction("load_pipeline_cache",        &Vireo::loadPipelineCache)
+            .addFunction("save_pipeline_cache",        &Vireo::savePipelineCache)
             .addFunction("create_buffer",              &Vireo::createBuffer)
             .addFunction("create_image",               &Vireo::createImage)
             .addFunction("create_read_write_image",    &Vireo::createReadWriteImage)
@@ -805,6 +829,7 @@ namespace vireo {
             .addFunction("create_sampler_descriptor_layout", &Vireo::createSamplerDescriptorLayout)
             .addFunction("create_dynamic_uniform_descriptor_layout", &Vireo::createDynamicUniformDescriptorLayout)
             .addFunction("create_descriptor_set",  &Vireo::createDescriptorSet)
+            .addFunction("create_transient_descriptor_allocator", &Vireo::createTransientDescriptorAllocator)
             .addFunction("create_sampler",         &Vireo::createSampler)
             .addStaticFunction("is_backend_supported",   &Vireo::isBackendSupported)
             .addProperty("shader_file_extension",    &Vireo::getShaderFileExtension)
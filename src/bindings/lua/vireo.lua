@@ -9,6 +9,7 @@
 ---@field UNDEFINED integer Unknown or uninitialized backend.
 ---@field DIRECTX integer DirectX 12 backend.
 ---@field VULKAN integer Vulkan backend.
+---@field NULL_RECORDER integer Backend without GPU, for CPU benchmarks.
 
 ---@class vireo.Filter Texture filtering mode for min/mag sampling.
 ---@field NEAREST integer Nearest-neighbor filtering (no interpolation, sharp).
@@ -393,6 +394,7 @@
 ---@field clear_depth_stencil boolean True to clear the depth/stencil attachment at the start of the render pass.
 ---@field depth_stencil_clear_value vireo.ClearValue Clear value for depth/stencil (use .depth and .stencil fields).
 ---@field discard_depth_stencil_after_render boolean True to discard the depth/stencil content after the render pass.
+---@field secondary_command_lists boolean True if the render pass content is recorded in secondary command lists executed with CommandList.execute_commands().
 
 ---@class vireo.DrawIndirectCommand GPU-side structure for an indirect (non-indexed) draw call. Mirror of VkDrawIndirectCommand / D3D12_DRAW_ARGUMENTS.
 ---@field vertex_count integer Number of vertices to draw per instance.
@@ -515,10 +517,19 @@
 ---@field update_sampler_array fun(self: vireo.DescriptorSet, index: vireo.DescriptorIndex, samplers: vireo.Sampler[]): nil Binds an array of samplers starting at the given binding index.
 ---@field layout vireo.DescriptorLayout The DescriptorLayout this set was created from. (read-only)
 
+---@class vireo.TransientDescriptorAllocator Linear allocator for descriptor sets used during a single frame. Created by Vireo.create_transient_descriptor_allocator().
+---@field create_descriptor_set fun(self: vireo.TransientDescriptorAllocator, layout: vireo.DescriptorLayout, name: string|nil): vireo.DescriptorSet Creates a descriptor set valid until the next reset(). Bindless layouts are not supported.
+---@field reset fun(self: vireo.TransientDescriptorAllocator): nil Releases all the descriptor sets created since the last reset. Call it once the GPU has finished the frame.
+
 ---@class vireo.VertexInputLayout Describes vertex buffer bindings and per-attribute formats for a graphics pipeline. Created by Vireo.create_vertex_layout(). Opaque; pass to GraphicPipelineConfiguration.vertex_input_layout.
 
 ---@class vireo.ShaderModule A compiled shader binary. Created by Vireo.create_shader_module_from_file() or Vireo.create_shader_module_from_data(). Opaque; pass to GraphicPipelineConfiguration or Vireo.create_compute_pipeline().
 
+---@class vireo.ShaderPack A set of shader modules loaded from a single shader pack file. Created by Vireo.load_shader_pack().
+---@field get fun(self: vireo.ShaderPack, name: string): vireo.ShaderModule Returns the shader module with the given name. Raises an error if the pack does not contain it.
+---@field contains fun(self: vireo.ShaderPack, name: string): boolean True if the pack contains a shader module with the given name.
+---@field size integer Number of shader modules in the pack. (read-only)
+
 ---@class vireo.PipelineResources The pipeline layout — describes which descriptor sets and push constants a pipeline uses. Created by Vireo.create_pipeline_resources(). Opaque.
 
 ---@class vireo.Pipeline Base type for compiled GPU pipelines. Use vireo.ComputePipeline or vireo.GraphicPipeline.
@@ -544,6 +555,8 @@
 ---@class vireo.CommandList Records a sequence of GPU commands for later submission. Obtained from CommandAllocator.create_command_list().
 ---@field begin fun(self: vireo.CommandList): nil Begins command recording. Must be called before any other recording command.
 ---@field end fun(self: vireo.CommandList): nil Ends command recording. Must be called before submitting to a queue.
+---@field begin_secondary fun(self: vireo.CommandList, primary: vireo.CommandList): nil Begins recording a secondary command list inheriting the render pass started in primary with secondary_command_lists = true.
+---@field execute_commands fun(self: vireo.CommandList, commandLists: vireo.CommandList[]): nil Executes secondary command lists inside the current render pass.
 ---@field upload_buffer fun(self: vireo.CommandList, destination: vireo.Buffer, data: lightuserdata|any): nil Copies CPU data into a BUFFER_UPLOAD staging buffer.
 ---@field upload_image fun(self: vireo.CommandList, destination: vireo.Image, data: lightuserdata|any, firstMipLevel: integer): nil Copies CPU data into an IMAGE_UPLOAD staging buffer starting at the given mip level.
 ---@field copy_buffer_to_image fun(self: vireo.CommandList, src: vireo.Buffer, dst: vireo.Image, mipLevel: integer, arrayLayer: integer, generateMips: boolean): nil Copies a staging buffer into a single image mip level and array layer; optionally generates remaining mips.
@@ -582,6 +595,7 @@
 ---@class vireo.CommandAllocator Manages a pool of command lists for a specific queue type. Created by Vireo.create_command_allocator().
 ---@field reset fun(self: vireo.CommandAllocator): nil Resets the allocator and all command lists it owns. Call once per frame before re-recording.
 ---@field create_command_list fun(self: vireo.CommandAllocator, pipeline: vireo.Pipeline|nil): vireo.CommandList Creates a new command list. Pass a pipeline to pre-bind it at creation time (graphics allocators only).
+---@field create_secondary_command_list fun(self: vireo.CommandAllocator): vireo.CommandList Creates a secondary command list, recorded with CommandList.begin_secondary() (graphics allocators only).
 ---@field command_list_type vireo.CommandType The command type this allocator was created for (GRAPHIC, TRANSFER, or COMPUTE). (read-only)
 
 ---@class vireo.SubmitQueue GPU command submission queue. Created by Vireo.create_submit_queue().
@@ -593,15 +607,18 @@
 ---@field submit_wait fun(self: vireo.SubmitQueue, waitSemaphore: vireo.Semaphore, waitStage: vireo.WaitStage, commandLists: vireo.CommandList[]): nil Submits after waiting on a GPU semaphore at the given pipeline stage.
 ---@field submit_signal fun(self: vireo.SubmitQueue, signalStage: vireo.WaitStage, signalSemaphore: vireo.Semaphore, commandLists: vireo.CommandList[]): nil Submits and signals a GPU semaphore when the given pipeline stage completes.
 ---@field wait_idle fun(self: vireo.SubmitQueue): nil Blocks the CPU until all submitted commands on this queue have finished executing.
+---@field set_deferred fun(self: vireo.SubmitQueue, deferred: boolean): nil In deferred mode the submissions are recorded and issued together by flush(). Disabling the deferred mode flushes the queue.
+---@field flush fun(self: vireo.SubmitQueue): nil Issues the submissions recorded in deferred mode.
 
 ---@class vireo.Vireo Main RHI entry point. Obtained from the host application; not constructed in Lua.
----@field backend vireo.Backend The active rendering backend (DIRECTX or VULKAN). (read-only)
+---@field backend vireo.Backend The active rendering backend (DIRECTX, VULKAN or NULL_RECORDER). (read-only)
 ---@field shader_file_extension string File extension for pre-compiled shaders on the active backend (e.g. ".spv" for Vulkan, ".cso" for DirectX). (read-only)
 ---@field physical_device vireo.PhysicalDevice The PhysicalDevice representing the selected GPU. (read-only)
 ---@field device vireo.Device The logical Device wrapping the GPU. (read-only)
 ---@field instance vireo.Instance The underlying API Instance (VkInstance / IDXGIFactory). (read-only)
 ---@field wait_idle fun(self: vireo.Vireo): nil Blocks the CPU until the GPU has finished all pending work on all queues.
 ---@field create_swap_chain fun(self: vireo.Vireo, format: vireo.ImageFormat, presentQueue: vireo.SubmitQueue, windowHandle: any, presentMode: vireo.PresentMode|nil, framesInFlight: integer|nil): vireo.SwapChain Creates a swap chain for the given OS window handle with optional presentation mode and frame count.
+---@field create_offscreen_swap_chain fun(self: vireo.Vireo, format: vireo.ImageFormat, presentQueue: vireo.SubmitQueue, extent: vireo.Extent, framesInFlight: integer|nil): vireo.SwapChain Creates a swap chain without window backed by a ring of render targets, for headless rendering (Vulkan only).
 ---@field create_submit_queue fun(self: vireo.Vireo, commandType: vireo.CommandType, name: string|nil): vireo.SubmitQueue Creates a GPU command submission queue for the given command type.
 ---@field create_fence fun(self: vireo.Vireo, createSignaled: boolean|nil, name: string|nil): vireo.Fence Creates a CPU/GPU fence (unsignaled by default; pass createSignaled=true to start in the signaled state).
 ---@field create_semaphore fun(self: vireo.Vireo, type: vireo.SemaphoreType, name: string|nil): vireo.Semaphore Creates a GPU synchronization semaphore of the given type.
@@ -609,9 +626,13 @@
 ---@field create_vertex_layout fun(self: vireo.Vireo, size: integer, attributes: vireo.VertexAttributeDesc[]): vireo.VertexInputLayout Creates a vertex input layout from a per-vertex stride (bytes) and a list of attribute descriptors.
 ---@field create_shader_module_from_file fun(self: vireo.Vireo, path: string): vireo.ShaderModule Loads a compiled shader binary from a file path (append shader_file_extension for the correct format).
 ---@field create_shader_module_from_data fun(self: vireo.Vireo, data: any, name: string): vireo.ShaderModule Creates a shader module from raw compiled byte data with an optional debug name.
+---@field load_shader_pack fun(self: vireo.Vireo, fileName: string): vireo.ShaderPack Loads a shader pack file (without the extensions, ".spv.pack" or ".dxil.pack" is appended) and creates all its shader modules in parallel.
 ---@field create_pipeline_resources fun(self: vireo.Vireo, layouts: vireo.DescriptorLayout[]|nil, pushConstant: vireo.PushConstantsDesc|nil, name: string|nil): vireo.PipelineResources Creates a pipeline layout from an ordered list of descriptor layouts and an optional push-constant range.
 ---@field create_compute_pipeline fun(self: vireo.Vireo, resources: vireo.PipelineResources, shader: vireo.ShaderModule, name: string|nil): vireo.ComputePipeline Compiles and returns a compute pipeline from a layout and a compute shader module.
 ---@field create_graphic_pipeline fun(self: vireo.Vireo, config: vireo.GraphicPipelineConfiguration, name: string|nil): vireo.GraphicPipeline Compiles and returns a graphics pipeline from a full configuration descriptor.
+---@field get_graphic_pipeline fun(self: vireo.Vireo, config: vireo.GraphicPipelineConfiguration, name: string|nil): vireo.GraphicPipeline Returns the graphics pipeline shared by all the identical configurations, compiled on the first call.
+---@field load_pipeline_cache fun(self: vireo.Vireo, fileName: string): boolean Loads the pipeline cache from a file written by save_pipeline_cache(). Returns false if the file is missing or was written by another device or driver.
+---@field save_pipeline_cache fun(self: vireo.Vireo, fileName: string): nil Writes the pipeline cache in a file.
 ---@field create_buffer fun(self: vireo.Vireo, type: vireo.BufferType, size: integer, count: integer|nil, name: string|nil): vireo.Buffer Allocates a GPU buffer. size is the per-element byte size; count is the number of elements (default 1).
 ---@field create_image fun(self: vireo.Vireo, format: vireo.ImageFormat, width: integer, height: integer, mipLevels: integer|nil, arraySize: integer|nil, name: string|nil): vireo.Image Allocates a shader-read-only GPU image.
 ---@field create_read_write_image fun(self: vireo.Vireo, format: vireo.ImageFormat, width: integer, height: integer, mipLevels: integer|nil, arraySize: integer|nil, name: string|nil): vireo.Image Allocates a GPU read/write image (UAV / storage image).
@@ -621,6 +642,7 @@
 ---@field create_sampler_descriptor_layout fun(self: vireo.Vireo, name: string|nil): vireo.DescriptorLayout Creates an empty descriptor layout intended for sampler-only bindings.
 ---@field create_dynamic_uniform_descriptor_layout fun(self: vireo.Vireo, name: string|nil): vireo.DescriptorLayout Creates an empty descriptor layout for dynamic uniform buffer bindings.
 ---@field create_descriptor_set fun(self: vireo.Vireo, layout: vireo.DescriptorLayout, name: string|nil): vireo.DescriptorSet Creates a descriptor set from a finalized DescriptorLayout.
+---@field create_transient_descriptor_allocator fun(self: vireo.Vireo, name: string|nil): vireo.TransientDescriptorAllocator Creates a linear allocator for descriptor sets used during one frame.
 ---@field create_sampler fun(self: vireo.Vireo, minFilter: vireo.Filter, magFilter: vireo.Filter, addressModeU: vireo.AddressMode, addressModeV: vireo.AddressMode, addressModeW: vireo.AddressMode, minLod: number|nil, maxLod: number|nil, anisotropyEnable: boolean|nil, mipMapMode: vireo.FilterMode|nil, compareOp: vireo.CompareOp|nil): vireo.Sampler Creates an immutable texture sampler with the given filtering, addressing, LOD, and comparison parameters.
 ---@field is_backend_supported fun(backend: vireo.Backend): boolean Returns true if the given rendering backend is available and supported on this machine. @static
 
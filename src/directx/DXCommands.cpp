@@ -173,10 +173,18 @@ namespace vireo {
         dxCheck(device->CreateCommandAllocator(
             DXCommandList::dxType[static_cast<int>(type)],
             IID_PPV_ARGS(&commandAllocator)));
+        if (type == CommandType::GRAPHIC) {
+            dxCheck(device->CreateCommandAllocator(
+                D3D12_COMMAND_LIST_TYPE_BUNDLE,
+                IID_PPV_ARGS(&bundleAllocator)));
+        }
     }
 
     void DXCommandAllocator::reset() const {
         dxCheck(commandAllocator->Reset());
+        if (bundleAllocator) {
+            dxCheck(bundleAllocator->Reset());
+        }
     }
 
     std::shared_ptr<CommandList> DXCommandAllocator::createCommandList(const Pipeline& pipeline) const {
@@ -197,18 +205,33 @@ namespace vireo {
             nullptr);
     }
 
+    std::shared_ptr<CommandList> DXCommandAllocator::createSecondaryCommandList() const {
+        if (getCommandListType() != CommandType::GRAPHIC) {
+            throw Exception("Secondary command lists are only supported for graphic command allocators");
+        }
+        return std::make_shared<DXCommandList>(
+            getCommandListType(),
+            device,
+            bundleAllocator,
+            descriptorHeaps,
+            nullptr,
+            true);
+    }
+
     DXCommandList::DXCommandList(
         const CommandType type,
         const ComPtr<ID3D12Device>& device,
         const ComPtr<ID3D12CommandAllocator>& commandAllocator,
         const std::vector<std::shared_ptr<DXDescriptorHeap>>& descriptorHeaps,
-        const ComPtr<ID3D12PipelineState>& pipelineState):
+        const ComPtr<ID3D12PipelineState>& pipelineState,
+        const bool bundle):
         device{device},
+        bundle{bundle},
         commandAllocator{commandAllocator},
         descriptorHeaps{descriptorHeaps} {
         dxCheck(device->CreateCommandList(
             0,
-            dxType[static_cast<int>(type)],
+            bundle ? D3D12_COMMAND_LIST_TYPE_BUNDLE : dxType[static_cast<int>(type)],
             commandAllocator.Get(),
             pipelineState == nullptr ? nullptr : pipelineState.Get(),
             IID_PPV_ARGS(&commandList)));
@@ -317,6 +340,7 @@ namespace vireo {
     }
 
     void DXCommandList::setViewports(const std::vector<Viewport>& viewports) const {
+        if (bundle) { return; }
         std::vector<CD3DX12_VIEWPORT> dxViewports(viewports.size());
         for (int i = 0; i < viewports.size(); i++) {
             dxViewports[i].TopLeftX = viewports[i].x;
@@ -330,6 +354,7 @@ namespace vireo {
     }
 
     void DXCommandList::setScissors(const std::vector<Rect>& rects) const {
+        if (bundle) { return; }
         std::vector<CD3DX12_RECT> scissors(rects.size());
         for (int i = 0; i < scissors.size(); i++) {
             scissors[i].left = rects[i].x;
@@ -341,6 +366,7 @@ namespace vireo {
     }
 
     void DXCommandList::setViewport(const Viewport& viewport) const {
+        if (bundle) { return; }
         const auto dxViewport = D3D12_VIEWPORT{
             .TopLeftX = viewport.x,
             .TopLeftY = viewport.y,
@@ -353,6 +379,7 @@ namespace vireo {
     }
 
     void DXCommandList::setScissors(const Rect& rect) const {
+        if (bundle) { return; }
         const auto scissor = D3D12_RECT{
             .left = rect.x,
             .top = rect.y,
@@ -562,156 +589,66 @@ namespace vireo {
         barrier(std::vector<ID3D12Resource*>{r.begin(), r.end()}, oldState, newState);
     }
 
+    void DXCommandList::barrier(const BarrierBatch& batch) const {
+        // Global memory dependencies only exist for unordered accesses with DirectX 12
+        for (const auto& memoryBarrier : batch.getMemoryBarriers()) {
+            if (memoryBarrier.oldState == ResourceState::COMPUTE_WRITE) {
+                const auto uavBarrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+                commandList->ResourceBarrier(1, &uavBarrier);
+                break;
+            }
+        }
+        for (const auto& bufferBarrier : batch.getBufferBarriers()) {
+            barrier(*bufferBarrier.buffer, bufferBarrier.oldState, bufferBarrier.newState);
+        }
+        for (const auto& imageBarrier : batch.getImageBarriers()) {
+            if (imageBarrier.image) {
+                barrier(
+                    imageBarrier.image,
+                    imageBarrier.oldState, imageBarrier.newState,
+                    imageBarrier.firstMipLevel,
+                    imageBarrier.levelCount == Image::ALL_MIP_LEVELS ?
+                        imageBarrier.image->getMipLevels() : imageBarrier.levelCount,
+                    imageBarrier.firstArrayLayer,
+                    imageBarrier.layerCount);
+            } else {
+                barrier(imageBarrier.swapChain, imageBarrier.oldState, imageBarrier.newState);
+            }
+        }
+    }
+
+    // D3D12 state of each ResourceState, indexed by ResourceState
+    constexpr auto resourceStates = std::array {
+        D3D12_RESOURCE_STATE_COMMON,                      // UNDEFINED
+        D3D12_RESOURCE_STATE_RENDER_TARGET,               // RENDER_TARGET_COLOR
+        D3D12_RESOURCE_STATE_DEPTH_WRITE,                 // RENDER_TARGET_DEPTH
+        D3D12_RESOURCE_STATE_DEPTH_READ,                  // RENDER_TARGET_DEPTH_READ
+        D3D12_RESOURCE_STATE_DEPTH_WRITE,                 // RENDER_TARGET_DEPTH_STENCIL
+        D3D12_RESOURCE_STATE_DEPTH_READ,                  // RENDER_TARGET_DEPTH_STENCIL_READ
+        D3D12_RESOURCE_STATE_PRESENT,                     // PRESENT
+        D3D12_RESOURCE_STATE_COPY_SOURCE,                 // COPY_SRC
+        D3D12_RESOURCE_STATE_COPY_DEST,                   // COPY_DST
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE |
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,   // SHADER_READ
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,   // COMPUTE_READ
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,            // COMPUTE_WRITE
+        D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,           // INDIRECT_DRAW
+        D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER |
+            D3D12_RESOURCE_STATE_INDEX_BUFFER,            // VERTEX_INPUT
+        D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER,  // UNIFORM
+    };
+    static_assert(resourceStates.size() == std::to_underlying(ResourceState::UNIFORM) + 1);
+
     void DXCommandList::convertState(
             const ResourceState oldState,
             const ResourceState newState,
             D3D12_RESOURCE_STATES& srcState,
             D3D12_RESOURCE_STATES& dstState) {
-        if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COMPUTE_WRITE) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::RENDER_TARGET_DEPTH) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COMPUTE_WRITE) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            dstState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::UNDEFINED &&
-                (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL || newState == ResourceState::RENDER_TARGET_DEPTH)) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        } else if ((oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL || oldState == ResourceState::RENDER_TARGET_DEPTH) &&
-                (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL_READ || newState == ResourceState::RENDER_TARGET_DEPTH_READ)) {
-            srcState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_READ;
-        } else if ((oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL_READ || oldState == ResourceState::RENDER_TARGET_DEPTH_READ) &&
-                (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL || newState == ResourceState::RENDER_TARGET_DEPTH)) {
-            srcState = D3D12_RESOURCE_STATE_DEPTH_READ;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        } else if (oldState == ResourceState::UNDEFINED &&
-                (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL_READ || newState == ResourceState::RENDER_TARGET_DEPTH_READ)) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_READ;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COPY_SRC) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::PRESENT) {
-            srcState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            dstState = D3D12_RESOURCE_STATE_PRESENT;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::PRESENT) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_PRESENT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::PRESENT) {
-            srcState = D3D12_RESOURCE_STATE_COPY_DEST;
-            dstState = D3D12_RESOURCE_STATE_PRESENT;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COPY_DST) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_COMMON; // Fix D3D12_BARRIER_LAYOUT_LEGACY_COPY_DEST need D3D12_BARRIER_LAYOUT_COMMON for CopyTextureRegion
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_COPY_DEST;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::RENDER_TARGET_DEPTH) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COPY_SRC) {
-            srcState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-            dstState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COPY_SRC) {
-            srcState = D3D12_RESOURCE_STATE_COMMON;
-            dstState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::COPY_SRC) {
-            srcState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            dstState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COMPUTE_WRITE) {
-            srcState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            dstState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COPY_DST) {
-            srcState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            dstState = D3D12_RESOURCE_STATE_COPY_DEST;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COPY_SRC) {
-            srcState = D3D12_RESOURCE_STATE_COPY_DEST;
-            dstState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COPY_SRC) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COPY_DST) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_COPY_DEST;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_COPY_DEST;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::COMPUTE_WRITE) {
-            srcState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-            dstState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COMPUTE_WRITE) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::SHADER_READ) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COMPUTE_READ) {
-            srcState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            dstState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-            dstState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        } else {
-            throw Exception("Not implemented");
-            return;
+        srcState = resourceStates[std::to_underlying(oldState)];
+        dstState = resourceStates[std::to_underlying(newState)];
+        if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COPY_DST) {
+            // Fix D3D12_BARRIER_LAYOUT_LEGACY_COPY_DEST need D3D12_BARRIER_LAYOUT_COMMON for CopyTextureRegion
+            dstState = D3D12_RESOURCE_STATE_COMMON;
         }
     }
 
@@ -915,10 +852,22 @@ namespace vireo {
         dxCheck(commandList->Reset(commandAllocator.Get(), nullptr));
     }
 
+    void DXCommandList::begin(const CommandList&) const {
+        assert(bundle);
+        begin();
+    }
+
     void DXCommandList::end() const {
         dxCheck(commandList->Close());
     }
 
+    void DXCommandList::executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        assert(!bundle);
+        for (const auto& bundleList : commandLists) {
+            commandList->ExecuteBundle(static_pointer_cast<const DXCommandList>(bundleList)->getCommandList().Get());
+        }
+    }
+
     void DXCommandList::cleanup() {
         stagingBuffers.clear();
     }
@@ -1556,7 +1505,11 @@ namespace vireo {
         return results;
     }
 
-    void DXCommandList::writeTimestamp(const QueryPool& queryPool, const uint32_t queryIndex) {
+    void DXCommandList::resetQueryPool(const QueryPool&, uint32_t, uint32_t) {
+        // D3D12 timestamp queries do not need a reset
+    }
+
+    void DXCommandList::writeTimestamp(const QueryPool& queryPool, const uint32_t queryIndex, WaitStage) {
         const auto& dxPool = static_cast<const DXQueryPool&>(queryPool);
         commandList->EndQuery(dxPool.getHeap(), D3D12_QUERY_TYPE_TIMESTAMP, queryIndex);
     }
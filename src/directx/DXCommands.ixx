@@ -114,6 +114,11 @@ export namespace vireo {
 
         void waitIdle() const override;
 
+        // ExecuteCommandLists() and Signal() are issued by each submit(), there is nothing to defer
+        void setDeferred(bool) override {}
+
+        void flush() const override {}
+
     private:
         ComPtr<ID3D12Device>       device;
         ComPtr<ID3D12CommandQueue> commandQueue;
@@ -132,9 +137,13 @@ export namespace vireo {
 
         std::shared_ptr<CommandList> createCommandList() const override;
 
+        std::shared_ptr<CommandList> createSecondaryCommandList() const override;
+
     private:
         ComPtr<ID3D12Device>           device;
         ComPtr<ID3D12CommandAllocator> commandAllocator;
+        // Allocator of the bundles used as secondary command lists, for graphic allocators only
+        ComPtr<ID3D12CommandAllocator> bundleAllocator;
         //List of current heaps to pass to the command lists
         std::vector<std::shared_ptr<DXDescriptorHeap>> descriptorHeaps;
     };
@@ -157,14 +166,19 @@ export namespace vireo {
             const ComPtr<ID3D12Device>& device,
             const ComPtr<ID3D12CommandAllocator>& commandAllocator,
             const std::vector<std::shared_ptr<DXDescriptorHeap>>& descriptorHeaps,
-            const ComPtr<ID3D12PipelineState>& pipelineState = nullptr);
+            const ComPtr<ID3D12PipelineState>& pipelineState = nullptr,
+            bool bundle = false);
 
         ~DXCommandList() override;
 
         void begin() const override;
 
+        void begin(const CommandList& primary) const override;
+
         void end() const override;
 
+        void executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
         void upload(
             const Buffer& destination,
             const void* source) override;
@@ -343,12 +357,16 @@ export namespace vireo {
            ResourceState oldState,
            ResourceState newState) const override;
 
+        void barrier(const BarrierBatch& batch) const override;
+
         void pushConstants(
             const std::shared_ptr<const PipelineResources>& pipelineResources,
             const PushConstantsDesc& pushConstants,
             const void* data) const override;
 
-        void writeTimestamp(const QueryPool& queryPool, uint32_t queryIndex) override;
+        void resetQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) override;
+
+        void writeTimestamp(const QueryPool& queryPool, uint32_t queryIndex, WaitStage stage) override;
 
         void resolveQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) override;
 
@@ -358,6 +376,8 @@ export namespace vireo {
 
     private:
         ComPtr<ID3D12Device>                device;
+        // Bundles inherit the render targets, viewports and scissors of the calling command list
+        const bool                          bundle;
         ComPtr<ID3D12GraphicsCommandList>   commandList;
         ComPtr<ID3D12CommandAllocator>      commandAllocator;
         // Staging buffers used by the upload() methods
@@ -32,6 +32,7 @@ namespace vireo {
         if ((!isDynamicUniform()) && type == DescriptorType::UNIFORM_DYNAMIC) {
             throw Exception("Use uniform dynamic descriptor layout for UNIFORM_DYNAMIC resources");
         }
+        types[index] = type;
         const auto unbounded = (
             (isBindless() && count > 1 && (
                 type == DescriptorType::SAMPLED_IMAGE ||
@@ -310,4 +311,20 @@ namespace vireo {
         }
     }
 
-}
\ No newline at end of file
+    void DXDescriptorSet::update(const std::vector<DescriptorWrite>& writes) {
+        // Descriptors are copied one by one in the heap, there is no batched write
+        for (const auto& write : writes) {
+            const auto index = write.index + write.arrayElement;
+            if (std::holds_alternative<std::shared_ptr<const Buffer>>(write.resource)) {
+                // Through the shared_ptr overload to keep the buffer of dynamic uniform sets, bound with their
+                // instance size. The other buffers are bound with their whole size.
+                update(index, std::get<std::shared_ptr<const Buffer>>(write.resource), !layout->isDynamicUniform());
+            } else if (std::holds_alternative<std::shared_ptr<const Image>>(write.resource)) {
+                update(index, *std::get<std::shared_ptr<const Image>>(write.resource), false);
+            } else {
+                update(index, *std::get<std::shared_ptr<const Sampler>>(write.resource));
+            }
+        }
+    }
+
+}
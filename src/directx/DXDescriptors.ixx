@@ -108,6 +108,8 @@ export namespace vireo {
 
         void update(DescriptorIndex index, const std::vector<std::shared_ptr<Sampler>>& samplers) override;
 
+        void update(const std::vector<DescriptorWrite>& writes) override;
+
         const auto& getDynamicBuffer() const { return dynamicBuffer; }
 
         const auto& getDescriptors() const { return descriptors; }
@@ -122,4 +124,35 @@ export namespace vireo {
         DXDescriptorHeap::DescriptorsArray descriptors;
     };
 
+    // Descriptor sets are allocated from the global heaps, the allocator keeps them until reset()
+    class DXTransientDescriptorAllocator : public TransientDescriptorAllocator {
+    public:
+        DXTransientDescriptorAllocator(
+            const std::shared_ptr<DXDescriptorHeap>& cbvSrvUavHeap,
+            const std::shared_ptr<DXDescriptorHeap>& samplerHeap,
+            const ComPtr<ID3D12Device>& device) :
+            cbvSrvUavHeap{cbvSrvUavHeap},
+            samplerHeap{samplerHeap},
+            device{device} {}
+
+        std::shared_ptr<DescriptorSet> createDescriptorSet(
+            const std::shared_ptr<const DescriptorLayout>& layout,
+            const std::string&) override {
+            const auto set = std::make_shared<DXDescriptorSet>(
+                layout->isSamplers() ? samplerHeap : cbvSrvUavHeap,
+                layout,
+                device);
+            descriptorSets.push_back(set);
+            return set;
+        }
+
+        void reset() override { descriptorSets.clear(); }
+
+    private:
+        std::shared_ptr<DXDescriptorHeap>           cbvSrvUavHeap;
+        std::shared_ptr<DXDescriptorHeap>           samplerHeap;
+        ComPtr<ID3D12Device>                        device;
+        std::vector<std::shared_ptr<DescriptorSet>> descriptorSets;
+    };
+
 }
\ No newline at end of file
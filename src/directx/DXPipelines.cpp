@@ -59,6 +59,12 @@ namespace vireo {
         memcpy(shader->GetBufferPointer(), data.data(), data.size());
     }
 
+    DXShaderModule::DXShaderModule(const std::span<const uint32_t> code, const std::string& _) {
+        // The D3D12 pipelines reference the bytecode until their creation, the blob keeps a copy
+        dxCheck(D3DCreateBlob(code.size_bytes(), &shader), "Error creating blob for  shader ");
+        memcpy(shader->GetBufferPointer(), code.data(), code.size_bytes());
+    }
+
     void DXShaderModule::load(std::ifstream& inputStream, const size_t size) {
         dxCheck(D3DCreateBlob(size, &shader), "Error creating blob for  shader ");
         inputStream.read(static_cast<char*>(shader->GetBufferPointer()), size);
@@ -45,6 +45,8 @@ export namespace vireo {
 
         DXShaderModule(const std::vector<char>& data, const std::string& name);
 
+        DXShaderModule(std::span<const uint32_t> code, const std::string& name);
+
         auto getShader() const { return shader; }
 
     private:
@@ -60,8 +60,7 @@ namespace vireo {
             nullptr,
             IID_PPV_ARGS(&buffer)));
         if constexpr (isMemoryUsageEnabled()) {
-            auto lock = std::lock_guard(memoryAllocationsMutex);
-            memoryAllocations.push_back({
+            addMemoryAllocation({
                 VideoMemoryAllocationUsage::BUFFER,
                 name,
                 bufferSize,
@@ -76,12 +75,6 @@ namespace vireo {
         if (mappedAddress) {
             DXBuffer::unmap();
         }
-        // if constexpr(isMemoryUsageEnabled()) {
-            // auto lock = std::lock_guard(memoryAllocationsMutex);
-            // memoryAllocations.remove_if([&](const VideoMemoryAllocationDesc& usage) {
-                // return usage.ref == buffer.Get();
-            // });
-        // }
     }
 
     void DXBuffer::map() {
@@ -174,8 +167,7 @@ namespace vireo {
             D3D12_RESOURCE_ALLOCATION_INFO allocInfo;
             device->GetResourceAllocationInfo(&allocInfo, 0,1, &imageDesc);
 #endif
-            auto lock = std::lock_guard(memoryAllocationsMutex);
-            memoryAllocations.push_back({
+            addMemoryAllocation({
                 VideoMemoryAllocationUsage::IMAGE,
                 name,
                 allocInfo.SizeInBytes,
@@ -187,12 +179,6 @@ namespace vireo {
     }
 
     DXImage::~DXImage() {
-        // if constexpr(isMemoryUsageEnabled()) {
-            // auto lock = std::lock_guard(memoryAllocationsMutex);
-            // memoryAllocations.remove_if([&](const VideoMemoryAllocationDesc& usage) {
-                // return usage.ref == image.Get();
-            // });
-        // }
     }
 
     DXSampler::DXSampler(
@@ -29,6 +29,10 @@ namespace vireo {
             config.directX12MaxSamplers);
     }
 
+    DXVireo::~DXVireo() {
+        stopCompilationThreads();
+    }
+
     std::shared_ptr<SwapChain> DXVireo::createSwapChain(
         const ImageFormat format,
         const std::shared_ptr<SubmitQueue>& submitQueue,
@@ -99,6 +103,11 @@ namespace vireo {
         return std::make_shared<DXShaderModule>(data, name);
     }
 
+    std::shared_ptr<ShaderModule> DXVireo::createShaderModule(
+        const std::span<const uint32_t> code, const std::string& name) const {
+        return std::make_shared<DXShaderModule>(code, name);
+    }
+
     std::shared_ptr<Buffer> DXVireo::createBuffer(
         const BufferType type,
         const size_t size,
@@ -236,6 +245,14 @@ namespace vireo {
             getDXDevice()->getDevice());
     }
 
+    std::shared_ptr<TransientDescriptorAllocator> DXVireo::createTransientDescriptorAllocator(
+        const std::string&) const {
+        return std::make_shared<DXTransientDescriptorAllocator>(
+            cbvSrvUavDescriptorHeap,
+            samplerDescriptorHeap,
+            getDXDevice()->getDevice());
+    }
+
     std::shared_ptr<Sampler> DXVireo::createSampler(
            Filter minFilter,
            Filter magFilter,
@@ -283,4 +300,28 @@ namespace vireo {
         return std::make_shared<DXQueryPool>(dxDevice, tempQueue, capacity, name);
     }
 
+    MemoryStatistics DXVireo::getMemoryStatistics() const {
+        const auto adapter = getDXPhysicalDevice()->getHardwareAdapter();
+        DXGI_ADAPTER_DESC3 desc;
+        dxCheck(adapter->GetDesc3(&desc));
+        // Committed resources are not sub-allocated : only the driver figures are available
+        auto statistics = MemoryStatistics {
+            .heaps = {
+                { .size = desc.DedicatedVideoMemory, .deviceLocal = true },
+                { .size = desc.SharedSystemMemory, .deviceLocal = false },
+            },
+        };
+        const DXGI_MEMORY_SEGMENT_GROUP groups[] = {
+            DXGI_MEMORY_SEGMENT_GROUP_LOCAL,
+            DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL,
+        };
+        for (int i = 0; i < 2; i++) {
+            DXGI_QUERY_VIDEO_MEMORY_INFO info;
+            dxCheck(adapter->QueryVideoMemoryInfo(0, groups[i], &info));
+            statistics.heaps[i].usage = info.CurrentUsage;
+            statistics.heaps[i].budget = info.Budget;
+        }
+        return statistics;
+    }
+
 }
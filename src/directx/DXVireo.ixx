@@ -18,6 +18,8 @@ export namespace vireo {
     public:
         DXVireo(const BackendConfiguration& config);
 
+        ~DXVireo() override;
+
         std::shared_ptr<SwapChain> createSwapChain(
             ImageFormat format,
             const std::shared_ptr<SubmitQueue>& submitQueue,
@@ -53,6 +55,10 @@ export namespace vireo {
             const std::vector<char>& data,
             const std::string& name) const override;
 
+        std::shared_ptr<ShaderModule> createShaderModule(
+            std::span<const uint32_t> code,
+            const std::string& name) const override;
+
         std::shared_ptr<PipelineResources> createPipelineResources(
             const std::vector<std::shared_ptr<DescriptorLayout>>& descriptorLayouts,
             const PushConstantsDesc& pushConstant,
@@ -124,6 +130,9 @@ export namespace vireo {
             const std::shared_ptr<const DescriptorLayout>& layout,
             const std::string& name) const override;
 
+        std::shared_ptr<TransientDescriptorAllocator> createTransientDescriptorAllocator(
+            const std::string& name) const override;
+
         std::shared_ptr<Sampler> createSampler(
            Filter minFilter,
            Filter magFilter,
@@ -148,6 +157,8 @@ export namespace vireo {
             return Backend::DIRECTX;
         }
 
+        MemoryStatistics getMemoryStatistics() const override;
+
         auto getDXInstance() const { return reinterpret_pointer_cast<DXInstance>(instance); }
 
         auto getDXPhysicalDevice() const { return reinterpret_pointer_cast<DXPhysicalDevice>(physicalDevice); }
@@ -0,0 +1,455 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.null.commands;
+
+namespace vireo {
+
+    NullQueryPool::NullQueryPool(const uint32_t capacity) :
+        // One tick per nanosecond
+        QueryPool{capacity, 1e-6},
+        timestamps(capacity) {
+    }
+
+    std::vector<uint64_t> NullQueryPool::getResults(const uint32_t firstQuery, const uint32_t queryCount) const {
+        assert(firstQuery + queryCount <= capacity);
+        return {timestamps.begin() + firstQuery, timestamps.begin() + firstQuery + queryCount};
+    }
+
+    void NullQueryPool::write(const uint32_t queryIndex) const {
+        assert(queryIndex < capacity);
+        timestamps[queryIndex] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void NullSubmitQueue::execute(
+        const std::shared_ptr<Fence>& fence,
+        const std::shared_ptr<Semaphore>& signalSemaphore,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        auto lock = std::lock_guard{submitMutex};
+        statistics->add(NullCounter::SUBMITS);
+        for (const auto& commandList : commandLists) {
+            const auto& nullCommandList = static_cast<const NullCommandList&>(*commandList);
+            statistics->add(NullCounter::COMMANDS, nullCommandList.getCommandCount());
+            statistics->add(NullCounter::STREAM_BYTES, nullCommandList.getStream().size() * sizeof(uint32_t));
+        }
+        if (signalSemaphore && signalSemaphore->getType() == SemaphoreType::TIMELINE) {
+            signalSemaphore->incrementValue();
+        }
+        if (fence) {
+            static_pointer_cast<NullFence>(fence)->signal();
+        }
+    }
+
+    void NullSubmitQueue::submit(
+        const std::shared_ptr<Fence>& fence,
+        const std::shared_ptr<const SwapChain>&,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        execute(fence, nullptr, commandLists);
+    }
+
+    void NullSubmitQueue::submit(
+        const std::shared_ptr<Semaphore>&,
+        const WaitStage,
+        const std::shared_ptr<Fence>& fence,
+        const std::shared_ptr<const SwapChain>&,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        execute(fence, nullptr, commandLists);
+    }
+
+    void NullSubmitQueue::submit(
+        const std::shared_ptr<Semaphore>&,
+        const std::vector<WaitStage>&,
+        const std::shared_ptr<Fence>& fence,
+        const std::shared_ptr<const SwapChain>&,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        execute(fence, nullptr, commandLists);
+    }
+
+    void NullSubmitQueue::submit(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        execute(nullptr, nullptr, commandLists);
+    }
+
+    void NullSubmitQueue::submit(
+        const std::shared_ptr<Fence>& fence,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        execute(fence, nullptr, commandLists);
+    }
+
+    void NullSubmitQueue::submit(
+        const std::shared_ptr<Semaphore>& waitSemaphore,
+        const WaitStage,
+        const WaitStage,
+        const std::shared_ptr<Semaphore>& signalSemaphore,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        assert(waitSemaphore != nullptr || signalSemaphore != nullptr);
+        execute(nullptr, signalSemaphore, commandLists);
+    }
+
+    void NullSubmitQueue::submit(
+        const std::shared_ptr<Semaphore>& waitSemaphore,
+        const std::vector<WaitStage>& waitStages,
+        const WaitStage,
+        const std::shared_ptr<Semaphore>& signalSemaphore,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        assert(waitSemaphore != nullptr || signalSemaphore != nullptr);
+        assert(waitSemaphore == nullptr || !waitStages.empty());
+        execute(nullptr, signalSemaphore, commandLists);
+    }
+
+    std::shared_ptr<CommandList> NullCommandAllocator::createCommandList(const Pipeline&) const {
+        return createCommandList();
+    }
+
+    std::shared_ptr<CommandList> NullCommandAllocator::createCommandList() const {
+        statistics->add(NullCounter::COMMAND_LISTS);
+        return std::make_shared<NullCommandList>();
+    }
+
+    std::shared_ptr<CommandList> NullCommandAllocator::createSecondaryCommandList() const {
+        return createCommandList();
+    }
+
+    void NullCommandList::record(const NullCommand command, const std::initializer_list<uint32_t> arguments) const {
+        stream.push_back(static_cast<uint32_t>(command) | static_cast<uint32_t>(arguments.size()) << 8);
+        stream.insert(stream.end(), arguments);
+        commandCount += 1;
+    }
+
+    void NullCommandList::begin() const {
+        // The capacity is kept between frames, like the memory of a real command buffer
+        stream.clear();
+        commandCount = 0;
+        record(NullCommand::BEGIN);
+    }
+
+    void NullCommandList::begin(const CommandList&) const {
+        begin();
+    }
+
+    void NullCommandList::end() const {
+        record(NullCommand::END);
+    }
+
+    void NullCommandList::executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        record(NullCommand::EXECUTE_COMMANDS, {static_cast<uint32_t>(commandLists.size())});
+    }
+
+    void NullCommandList::upload(const Buffer& destination, const void* source) {
+        assert(source != nullptr);
+        record(NullCommand::UPLOAD, {static_cast<uint32_t>(destination.getSize())});
+    }
+
+    void NullCommandList::upload(const Image& destination, const void* source, const uint32_t firstMipLevel) {
+        assert(source != nullptr);
+        record(NullCommand::UPLOAD, {destination.getImageSize(firstMipLevel), firstMipLevel});
+    }
+
+    void NullCommandList::copy(
+        const Buffer&,
+        const Image&,
+        const uint32_t sourceOffset,
+        const uint32_t mipLevel,
+        const bool) const {
+        record(NullCommand::COPY, {sourceOffset, mipLevel});
+    }
+
+    void NullCommandList::copy(
+        const Buffer&,
+        const Image&,
+        const std::vector<size_t>& sourceOffsets,
+        const bool) const {
+        record(NullCommand::COPY, {static_cast<uint32_t>(sourceOffsets.size())});
+    }
+
+    void NullCommandList::copy(
+        const Image&,
+        const Buffer&,
+        const uint32_t destinationOffset,
+        const uint32_t mipLevel) const {
+        record(NullCommand::COPY, {destinationOffset, mipLevel});
+    }
+
+    void NullCommandList::copy(
+        const Buffer& source,
+        const Buffer&,
+        const size_t size,
+        const uint32_t sourceOffset,
+        const uint32_t destinationOffset) const {
+        const auto copySize = size == Buffer::WHOLE_SIZE ? source.getSize() : size;
+        record(NullCommand::COPY, {static_cast<uint32_t>(copySize), sourceOffset, destinationOffset});
+    }
+
+    void NullCommandList::copy(
+        const Buffer&,
+        const Buffer&,
+        const std::vector<BufferCopyRegion>& regions) const {
+        record(NullCommand::COPY, {static_cast<uint32_t>(regions.size())});
+    }
+
+    void NullCommandList::copy(
+        const Image&,
+        const Image&,
+        const uint32_t mipLevel,
+        const uint32_t sourceFirstArrayLayer,
+        const uint32_t destinationFirstArrayLayer,
+        const uint32_t layerCount) const {
+        record(NullCommand::COPY, {mipLevel, sourceFirstArrayLayer, destinationFirstArrayLayer, layerCount});
+    }
+
+    void NullCommandList::uploadArray(
+        const Image&,
+        const std::vector<void*>& sources,
+        const uint32_t firstMipLevel) {
+        record(NullCommand::UPLOAD, {static_cast<uint32_t>(sources.size()), firstMipLevel});
+    }
+
+    void NullCommandList::copy(const Image&, const SwapChain&) const {
+        record(NullCommand::COPY);
+    }
+
+    void NullCommandList::beginRendering(const RenderingConfiguration& conf) {
+        record(NullCommand::BEGIN_RENDERING, {
+            static_cast<uint32_t>(conf.colorRenderTargets.size()),
+            conf.depthStencilRenderTarget != nullptr});
+    }
+
+    void NullCommandList::endRendering() {
+        record(NullCommand::END_RENDERING);
+    }
+
+    void NullCommandList::dispatch(const uint32_t x, const uint32_t y, const uint32_t z) const {
+        record(NullCommand::DISPATCH, {x, y, z});
+    }
+
+    void NullCommandList::bindVertexBuffers(
+        const std::vector<std::shared_ptr<const Buffer>>& buffers,
+        const std::vector<size_t> offsets) const {
+        assert(offsets.empty() || offsets.size() == buffers.size());
+        record(NullCommand::BIND_VERTEX_BUFFERS, {static_cast<uint32_t>(buffers.size())});
+    }
+
+    void NullCommandList::bindVertexBuffer(const Buffer&, const size_t offset) const {
+        record(NullCommand::BIND_VERTEX_BUFFERS, {1, static_cast<uint32_t>(offset)});
+    }
+
+    void NullCommandList::bindIndexBuffer(const Buffer&, const IndexType indexType, const uint32_t firstIndex) const {
+        record(NullCommand::BIND_INDEX_BUFFER, {static_cast<uint32_t>(indexType), firstIndex});
+    }
+
+    void NullCommandList::bindPipeline(Pipeline& pipeline, const bool) {
+        currentlyBoundPipeline = &pipeline;
+        record(NullCommand::BIND_PIPELINE, {static_cast<uint32_t>(pipeline.getType())});
+    }
+
+    void NullCommandList::bindDescriptors(
+        const PipelineType pipelineType,
+        const std::shared_ptr<PipelineResources>&,
+        const std::vector<std::shared_ptr<const DescriptorSet>>& descriptors,
+        const uint32_t firstSet) const {
+        record(NullCommand::BIND_DESCRIPTORS, {
+            static_cast<uint32_t>(pipelineType),
+            static_cast<uint32_t>(descriptors.size()),
+            firstSet});
+    }
+
+    void NullCommandList::bindDescriptors(
+        const std::vector<std::shared_ptr<const DescriptorSet>>& descriptors,
+        const uint32_t firstSet) const {
+        assert(currentlyBoundPipeline != nullptr);
+        bindDescriptors(currentlyBoundPipeline->getType(), nullptr, descriptors, firstSet);
+    }
+
+    void NullCommandList::bindDescriptor(const DescriptorSet&, const uint32_t set) const {
+        assert(currentlyBoundPipeline != nullptr);
+        record(NullCommand::BIND_DESCRIPTORS, {static_cast<uint32_t>(currentlyBoundPipeline->getType()), 1, set});
+    }
+
+    void NullCommandList::bindDescriptor(const DescriptorSet&, const uint32_t set, const uint32_t offset) const {
+        assert(currentlyBoundPipeline != nullptr);
+        record(NullCommand::BIND_DESCRIPTORS, {
+            static_cast<uint32_t>(currentlyBoundPipeline->getType()), 1, set, offset});
+    }
+
+    void NullCommandList::draw(
+        const uint32_t vertexCountPerInstance,
+        const uint32_t instanceCount,
+        const uint32_t firstVertex,
+        const uint32_t firstInstance) const {
+        record(NullCommand::DRAW, {vertexCountPerInstance, instanceCount, firstVertex, firstInstance});
+    }
+
+    void NullCommandList::drawIndirect(
+        const Buffer&,
+        const size_t offset,
+        const uint32_t drawCount,
+        const uint32_t stride,
+        const uint32_t firstCommandOffset) {
+        record(NullCommand::DRAW_INDIRECT, {
+            static_cast<uint32_t>(offset), drawCount, stride, firstCommandOffset});
+    }
+
+    void NullCommandList::drawIndexed(
+        const uint32_t indexCountPerInstance,
+        const uint32_t instanceCount,
+        const uint32_t firstIndex,
+        const uint32_t firstVertex,
+        const uint32_t firstInstance) const {
+        record(NullCommand::DRAW_INDEXED, {indexCountPerInstance, instanceCount, firstIndex, firstVertex, firstInstance});
+    }
+
+    void NullCommandList::drawIndexedIndirect(
+        const Buffer&,
+        const size_t offset,
+        const uint32_t drawCount,
+        const uint32_t stride,
+        const uint32_t firstCommandOffset) {
+        record(NullCommand::DRAW_INDIRECT, {
+            static_cast<uint32_t>(offset), drawCount, stride, firstCommandOffset});
+    }
+
+    void NullCommandList::drawIndexedIndirectCount(
+        Buffer&,
+        const size_t offset,
+        Buffer&,
+        const size_t countOffset,
+        const uint32_t maxDrawCount,
+        const uint32_t stride,
+        const uint32_t firstCommandOffset) {
+        record(NullCommand::DRAW_INDIRECT, {
+            static_cast<uint32_t>(offset), maxDrawCount, stride, firstCommandOffset, static_cast<uint32_t>(countOffset)});
+    }
+
+    void NullCommandList::setViewports(const std::vector<Viewport>& viewports) const {
+        record(NullCommand::SET_VIEWPORTS, {static_cast<uint32_t>(viewports.size())});
+    }
+
+    void NullCommandList::setScissors(const std::vector<Rect>& rects) const {
+        record(NullCommand::SET_SCISSORS, {static_cast<uint32_t>(rects.size())});
+    }
+
+    void NullCommandList::setViewport(const Viewport&) const {
+        record(NullCommand::SET_VIEWPORTS, {1});
+    }
+
+    void NullCommandList::setScissors(const Rect&) const {
+        record(NullCommand::SET_SCISSORS, {1});
+    }
+
+    void NullCommandList::setStencilReference(const uint32_t reference) const {
+        record(NullCommand::SET_STENCIL_REFERENCE, {reference});
+    }
+
+    void NullCommandList::barrier(
+        const std::shared_ptr<const Image>& image,
+        const ResourceState oldState,
+        const ResourceState newState,
+        const uint32_t,
+        const uint32_t,
+        const uint32_t,
+        const uint32_t) const {
+        assert(image != nullptr);
+        record(NullCommand::BARRIER, {1, static_cast<uint32_t>(oldState), static_cast<uint32_t>(newState)});
+    }
+
+    void NullCommandList::barrier(
+        const std::shared_ptr<const RenderTarget>& renderTarget,
+        const ResourceState oldState,
+        const ResourceState newState,
+        const uint32_t,
+        const uint32_t) const {
+        assert(renderTarget != nullptr);
+        record(NullCommand::BARRIER, {1, static_cast<uint32_t>(oldState), static_cast<uint32_t>(newState)});
+    }
+
+    void NullCommandList::barrier(
+        const std::shared_ptr<const SwapChain>& swapChain,
+        const ResourceState oldState,
+        const ResourceState newState) const {
+        assert(swapChain != nullptr);
+        record(NullCommand::BARRIER, {1, static_cast<uint32_t>(oldState), static_cast<uint32_t>(newState)});
+    }
+
+    void NullCommandList::barrier(
+        const std::vector<std::shared_ptr<const Image>>& images,
+        const ResourceState oldState,
+        const ResourceState newState,
+        const uint32_t,
+        const uint32_t) const {
+        record(NullCommand::BARRIER, {
+            static_cast<uint32_t>(images.size()), static_cast<uint32_t>(oldState), static_cast<uint32_t>(newState)});
+    }
+
+    void NullCommandList::barrier(
+        const std::vector<std::shared_ptr<const RenderTarget>>& renderTargets,
+        const ResourceState oldState,
+        const ResourceState newState,
+        const uint32_t,
+        const uint32_t) const {
+        record(NullCommand::BARRIER, {
+            static_cast<uint32_t>(renderTargets.size()), static_cast<uint32_t>(oldState), static_cast<uint32_t>(newState)});
+    }
+
+    void NullCommandList::barrier(
+        const Buffer&,
+        const ResourceState oldState,
+        const ResourceState newState) const {
+        record(NullCommand::BARRIER, {1, static_cast<uint32_t>(oldState), static_cast<uint32_t>(newState)});
+    }
+
+    void NullCommandList::barrier(const BarrierBatch& batch) const {
+        if (batch.empty()) { return; }
+        record(NullCommand::BARRIER, {static_cast<uint32_t>(
+            batch.getImageBarriers().size() +
+            batch.getBufferBarriers().size() +
+            batch.getMemoryBarriers().size())});
+    }
+
+    void NullCommandList::pushConstants(
+        const std::shared_ptr<const PipelineResources>&,
+        const PushConstantsDesc& pushConstants,
+        const void* data) const {
+        assert(data != nullptr);
+        record(NullCommand::PUSH_CONSTANTS, {pushConstants.offset, pushConstants.size});
+    }
+
+    void NullCommandList::resetQueryPool(const QueryPool&, const uint32_t firstQuery, const uint32_t queryCount) {
+        record(NullCommand::RESET_QUERY_POOL, {firstQuery, queryCount});
+    }
+
+    void NullCommandList::writeTimestamp(const QueryPool& queryPool, const uint32_t queryIndex, const WaitStage stage) {
+        static_cast<const NullQueryPool&>(queryPool).write(queryIndex);
+        record(NullCommand::WRITE_TIMESTAMP, {queryIndex, static_cast<uint32_t>(stage)});
+    }
+
+    void NullCommandList::resolveQueryPool(const QueryPool&, const uint32_t firstQuery, const uint32_t queryCount) {
+        record(NullCommand::RESOLVE_QUERY_POOL, {firstQuery, queryCount});
+    }
+
+    NullSwapChain::NullSwapChain(
+        const ImageFormat format,
+        const PresentMode presentMode,
+        const Extent& extent,
+        const uint32_t framesInFlight) :
+        SwapChain{format, presentMode, framesInFlight} {
+        this->extent = extent;
+        aspectRatio = static_cast<float>(extent.width) / static_cast<float>(extent.height);
+    }
+
+    void NullSwapChain::nextFrameIndex() {
+        currentFrameIndex = (currentFrameIndex + 1) % framesInFlight;
+    }
+
+    bool NullSwapChain::acquire(const std::shared_ptr<Fence>& fence) {
+        assert(fence != nullptr);
+        fence->wait();
+        fence->reset();
+        return true;
+    }
+
+}
@@ -0,0 +1,384 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.null.commands;
+
+import std;
+import vireo;
+
+import vireo.null.resources;
+
+export namespace vireo {
+
+    /**
+     * Opcodes of the command streams recorded by NullCommandList
+     */
+    enum class NullCommand : uint8_t {
+        BEGIN,
+        END,
+        EXECUTE_COMMANDS,
+        UPLOAD,
+        COPY,
+        BEGIN_RENDERING,
+        END_RENDERING,
+        DISPATCH,
+        BIND_VERTEX_BUFFERS,
+        BIND_INDEX_BUFFER,
+        BIND_PIPELINE,
+        BIND_DESCRIPTORS,
+        DRAW,
+        DRAW_INDEXED,
+        DRAW_INDIRECT,
+        SET_VIEWPORTS,
+        SET_SCISSORS,
+        SET_STENCIL_REFERENCE,
+        BARRIER,
+        PUSH_CONSTANTS,
+        WRITE_TIMESTAMP,
+        RESOLVE_QUERY_POOL,
+        RESET_QUERY_POOL,
+    };
+
+    // Timestamps are written with the CPU clock when recorded
+    class NullQueryPool : public QueryPool {
+    public:
+        NullQueryPool(uint32_t capacity);
+
+        std::vector<uint64_t> getResults(uint32_t firstQuery, uint32_t queryCount) const override;
+
+        void write(uint32_t queryIndex) const;
+
+    private:
+        mutable std::vector<uint64_t> timestamps;
+    };
+
+    class NullFence : public Fence {
+    public:
+        NullFence(const bool createSignaled) : signaled{createSignaled} {}
+
+        // Submissions are executed immediately, the fence is always signaled when waited
+        void wait() const override {}
+
+        void reset() override { signaled = false; }
+
+        void signal() { signaled = true; }
+
+        auto isSignaled() const { return signaled; }
+
+    private:
+        bool signaled;
+    };
+
+    class NullSubmitQueue : public SubmitQueue {
+    public:
+        NullSubmitQueue(const std::shared_ptr<NullStatistics>& statistics) : statistics{statistics} {}
+
+        void submit(
+            const std::shared_ptr<Fence>& fence,
+            const std::shared_ptr<const SwapChain>& swapChain,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void submit(
+            const std::shared_ptr<Semaphore>& waitSemaphore,
+            WaitStage waitStage,
+            const std::shared_ptr<Fence>& fence,
+            const std::shared_ptr<const SwapChain>& swapChain,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void submit(
+            const std::shared_ptr<Semaphore>& waitSemaphore,
+            const std::vector<WaitStage>& waitStages,
+            const std::shared_ptr<Fence>& fence,
+            const std::shared_ptr<const SwapChain>& swapChain,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void submit(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void submit(
+            const std::shared_ptr<Fence>& fence,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void submit(
+            const std::shared_ptr<Semaphore>& waitSemaphore,
+            WaitStage waitStage,
+            WaitStage signalStage,
+            const std::shared_ptr<Semaphore>& signalSemaphore,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void submit(
+            const std::shared_ptr<Semaphore>& waitSemaphore,
+            const std::vector<WaitStage>& waitStages,
+            WaitStage signalStage,
+            const std::shared_ptr<Semaphore>& signalSemaphore,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void waitIdle() const override {}
+
+        // Submissions are executed immediately, there is nothing to batch
+        void setDeferred(bool) override {}
+
+        void flush() const override {}
+
+    private:
+        const std::shared_ptr<NullStatistics> statistics;
+
+        void execute(
+            const std::shared_ptr<Fence>& fence,
+            const std::shared_ptr<Semaphore>& signalSemaphore,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists) const;
+    };
+
+    class NullCommandAllocator : public CommandAllocator {
+    public:
+        NullCommandAllocator(const std::shared_ptr<NullStatistics>& statistics, CommandType type) :
+            CommandAllocator{type},
+            statistics{statistics} {}
+
+        void reset() const override {}
+
+        std::shared_ptr<CommandList> createCommandList(const Pipeline& pipeline) const override;
+
+        std::shared_ptr<CommandList> createCommandList() const override;
+
+        std::shared_ptr<CommandList> createSecondaryCommandList() const override;
+
+    private:
+        const std::shared_ptr<NullStatistics> statistics;
+    };
+
+    /**
+     * Records the commands in a compact stream of 32 bits words. Each command is a header word, with the opcode in the
+     * low byte and the number of arguments in the next byte, followed by the arguments. Resources are not recorded.
+     */
+    class NullCommandList : public CommandList {
+    public:
+        NullCommandList() = default;
+
+        void begin() const override;
+
+        void begin(const CommandList& primary) const override;
+
+        void end() const override;
+
+        void executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
+        void cleanup() override {}
+
+        void upload(const Buffer& destination, const void* source) override;
+
+        void upload(const Image& destination, const void* source, uint32_t firstMipLevel) override;
+
+        void copy(
+            const Buffer& source,
+            const Image& destination,
+            uint32_t sourceOffset,
+            uint32_t mipLevel,
+            bool rowPitchAlignment) const override;
+
+        void copy(
+            const Buffer& source,
+            const Image& destination,
+            const std::vector<size_t>& sourceOffsets,
+            bool rowPitchAlignment) const override;
+
+        void copy(
+            const Image& source,
+            const Buffer& destination,
+            uint32_t destinationOffset,
+            uint32_t mipLevel) const override;
+
+        void copy(
+            const Buffer& source,
+            const Buffer& destination,
+            size_t size,
+            uint32_t sourceOffset,
+            uint32_t destinationOffset) const override;
+
+        void copy(
+            const Buffer& source,
+            const Buffer& destination,
+            const std::vector<BufferCopyRegion>& regions) const override;
+
+        void copy(
+            const Image& source,
+            const Image& destination,
+            uint32_t mipLevel,
+            uint32_t sourceFirstArrayLayer,
+            uint32_t destinationFirstArrayLayer,
+            uint32_t layerCount) const override;
+
+        void uploadArray(
+            const Image& destination,
+            const std::vector<void*>& sources,
+            uint32_t firstMipLevel) override;
+
+        void copy(const Image& source, const SwapChain& swapChain) const override;
+
+        void beginRendering(const RenderingConfiguration& conf) override;
+
+        void endRendering() override;
+
+        void dispatch(uint32_t x, uint32_t y, uint32_t z) const override;
+
+        void bindVertexBuffers(
+            const std::vector<std::shared_ptr<const Buffer>>& buffers,
+            std::vector<size_t> offsets = {}) const override;
+
+        void bindVertexBuffer(const Buffer& buffer, size_t offset) const override;
+
+        void bindIndexBuffer(const Buffer& buffer, IndexType indexType, uint32_t firstIndex) const override;
+
+        void bindPipeline(Pipeline& pipeline, bool descriptorsAlreadyBounds) override;
+
+        void bindDescriptors(
+            PipelineType pipelineType,
+            const std::shared_ptr<PipelineResources>& pipelineResources,
+            const std::vector<std::shared_ptr<const DescriptorSet>>& descriptors,
+            uint32_t firstSet) const override;
+
+        void bindDescriptors(
+            const std::vector<std::shared_ptr<const DescriptorSet>>& descriptors,
+            uint32_t firstSet) const override;
+
+        void bindDescriptor(const DescriptorSet& descriptor, uint32_t set) const override;
+
+        void bindDescriptor(const DescriptorSet& descriptor, uint32_t set, uint32_t offset) const override;
+
+        void draw(
+            uint32_t vertexCountPerInstance,
+            uint32_t instanceCount = 1,
+            uint32_t firstVertex = 0,
+            uint32_t firstInstance = 0) const override;
+
+        void drawIndirect(
+            const Buffer& buffer,
+            size_t offset,
+            uint32_t drawCount,
+            uint32_t stride,
+            uint32_t firstCommandOffset) override;
+
+        void drawIndexed(
+            uint32_t indexCountPerInstance,
+            uint32_t instanceCount = 1,
+            uint32_t firstIndex = 0,
+            uint32_t firstVertex = 0,
+            uint32_t firstInstance = 0) const override;
+
+        void drawIndexedIndirect(
+            const Buffer& buffer,
+            size_t offset,
+            uint32_t drawCount,
+            uint32_t stride,
+            uint32_t firstCommandOffset) override;
+
+        void drawIndexedIndirectCount(
+            Buffer& buffer,
+            size_t offset,
+            Buffer& countBuffer,
+            size_t countOffset,
+            uint32_t maxDrawCount,
+            uint32_t stride,
+            uint32_t firstCommandOffset) override;
+
+        void setViewports(const std::vector<Viewport>& viewports) const override;
+
+        void setScissors(const std::vector<Rect>& rects) const override;
+
+        void setViewport(const Viewport& viewport) const override;
+
+        void setScissors(const Rect& rect) const override;
+
+        void setStencilReference(uint32_t reference) const override;
+
+        void barrier(
+            const std::shared_ptr<const Image>& image,
+            ResourceState oldState,
+            ResourceState newState,
+            uint32_t firstMipLevel,
+            uint32_t levelCount,
+            uint32_t firstArrayLayer,
+            uint32_t layerCount) const override;
+
+        void barrier(
+            const std::shared_ptr<const RenderTarget>& renderTarget,
+            ResourceState oldState,
+            ResourceState newState,
+            uint32_t firstArrayLayer,
+            uint32_t layerCount) const override;
+
+        void barrier(
+            const std::shared_ptr<const SwapChain>& swapChain,
+            ResourceState oldState,
+            ResourceState newState) const override;
+
+        void barrier(
+            const std::vector<std::shared_ptr<const Image>>& images,
+            ResourceState oldState,
+            ResourceState newState,
+            uint32_t firstArrayLayer,
+            uint32_t layerCount) const override;
+
+        void barrier(
+            const std::vector<std::shared_ptr<const RenderTarget>>& renderTargets,
+            ResourceState oldState,
+            ResourceState newState,
+            uint32_t firstArrayLayer,
+            uint32_t layerCount) const override;
+
+        void barrier(
+            const Buffer& buffer,
+            ResourceState oldState,
+            ResourceState newState) const override;
+
+        void barrier(const BarrierBatch& batch) const override;
+
+        void pushConstants(
+            const std::shared_ptr<const PipelineResources>& pipelineResources,
+            const PushConstantsDesc& pushConstants,
+            const void* data) const override;
+
+        void resetQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) override;
+
+        void writeTimestamp(const QueryPool& queryPool, uint32_t queryIndex, WaitStage stage) override;
+
+        void resolveQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) override;
+
+        /**
+         * Returns the commands recorded since the last begin()
+         */
+        const auto& getStream() const { return stream; }
+
+        /**
+         * Returns the number of commands recorded since the last begin()
+         */
+        auto getCommandCount() const { return commandCount; }
+
+    private:
+        mutable std::vector<uint32_t> stream;
+        mutable uint32_t              commandCount{0};
+
+        void record(NullCommand command, std::initializer_list<uint32_t> arguments = {}) const;
+    };
+
+    class NullSwapChain : public SwapChain {
+    public:
+        //! Extent of the swap chains created with a window
+        static constexpr Extent DEFAULT_EXTENT{1920, 1080};
+
+        NullSwapChain(ImageFormat format, PresentMode presentMode, const Extent& extent, uint32_t framesInFlight);
+
+        void nextFrameIndex() override;
+
+        bool acquire(const std::shared_ptr<Fence>& fence) override;
+
+        void present() override {}
+
+        void recreate() override {}
+
+        void waitIdle() override {}
+    };
+
+}
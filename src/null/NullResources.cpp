@@ -0,0 +1,142 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.null.resources;
+
+namespace vireo {
+
+    NullBuffer::NullBuffer(
+        const std::shared_ptr<NullStatistics>& statistics,
+        const BufferType type,
+        const size_t size,
+        const size_t count,
+        const std::string& name) : Buffer{type} {
+        const auto alignment = type == BufferType::UNIFORM ? UNIFORM_ALIGNMENT : 1;
+        instanceSizeAligned = static_cast<uint32_t>((size + alignment - 1) & ~(alignment - 1));
+        bufferSize = instanceSizeAligned * count;
+        instanceSize = static_cast<uint32_t>(size);
+        instanceCount = static_cast<uint32_t>(count);
+        statistics->add(NullCounter::BUFFERS);
+        statistics->add(NullCounter::BUFFER_BYTES, bufferSize);
+    }
+
+    void NullBuffer::map() {
+        assert(mappedAddress == nullptr);
+        if (memory.empty()) {
+            memory.resize(bufferSize);
+        }
+        mappedAddress = memory.data();
+    }
+
+    void NullBuffer::unmap() {
+        mappedAddress = nullptr;
+    }
+
+    NullImage::NullImage(
+        const std::shared_ptr<NullStatistics>& statistics,
+        const ImageFormat format,
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t mipLevels,
+        const uint32_t arraySize,
+        const bool isReadWrite,
+        const std::string& name) :
+        Image{format, width, height, mipLevels, arraySize, isReadWrite, name} {
+        auto size = uint64_t{0};
+        for (auto mipLevel = 0u; mipLevel < mipLevels; mipLevel++) {
+            size += getImageSize(mipLevel);
+        }
+        statistics->add(NullCounter::IMAGES);
+        statistics->add(NullCounter::IMAGE_BYTES, size * arraySize);
+    }
+
+    std::shared_ptr<RenderTarget> NullRenderTarget::fromLayer(const uint32_t imageLayer) {
+        assert(imageLayer < getImage()->getArraySize());
+        return std::make_shared<NullRenderTarget>(getType(), getImage());
+    }
+
+    DescriptorLayout& NullDescriptorLayout::add(const DescriptorIndex index, const DescriptorType type, const size_t count) {
+        // Same validation as the real backends
+        if (isSamplers() && type != DescriptorType::SAMPLER) {
+            throw Exception("Sampler descriptor layout only accepts SAMPLER resources");
+        }
+        if ((!isSamplers()) && type == DescriptorType::SAMPLER) {
+            throw Exception("Use Sampler descriptor layout for SAMPLER resources");
+        }
+        if (isDynamicUniform() && type != DescriptorType::UNIFORM_DYNAMIC) {
+            throw Exception("Uniform dynamic descriptor layout only accepts UNIFORM_DYNAMIC resources");
+        }
+        if ((!isDynamicUniform()) && type == DescriptorType::UNIFORM_DYNAMIC) {
+            throw Exception("Use uniform dynamic descriptor layout for UNIFORM_DYNAMIC resources");
+        }
+        types[index] = type;
+        capacity += count;
+        return *this;
+    }
+
+    NullDescriptorSet::NullDescriptorSet(
+        const std::shared_ptr<NullStatistics>& statistics,
+        const std::shared_ptr<const DescriptorLayout>& layout) :
+        DescriptorSet{layout},
+        statistics{statistics} {
+        statistics->add(NullCounter::DESCRIPTOR_SETS);
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const std::shared_ptr<const Buffer>& buffer, const bool) {
+        assert(buffer != nullptr);
+        statistics->add(NullCounter::DESCRIPTOR_WRITES);
+    }
+
+    void NullDescriptorSet::update(
+        const DescriptorIndex,
+        const std::shared_ptr<const Buffer>& buffer,
+        const std::shared_ptr<const Buffer>& counterBuffer) {
+        assert(buffer != nullptr && counterBuffer != nullptr);
+        statistics->add(NullCounter::DESCRIPTOR_WRITES);
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const Buffer&, const Buffer&) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES);
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const Buffer&, const bool) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES);
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const Image&, const bool) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES);
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const Sampler&) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES);
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const std::vector<std::shared_ptr<Image>>& images) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES, images.size());
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const std::vector<std::shared_ptr<Buffer>>& buffers) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES, buffers.size());
+    }
+
+    void NullDescriptorSet::update(const DescriptorIndex, const std::vector<std::shared_ptr<Sampler>>& samplers) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES, samplers.size());
+    }
+
+    void NullDescriptorSet::update(const std::vector<DescriptorWrite>& writes) {
+        statistics->add(NullCounter::DESCRIPTOR_WRITES, writes.size());
+    }
+
+    std::shared_ptr<DescriptorSet> NullTransientDescriptorAllocator::createDescriptorSet(
+        const std::shared_ptr<const DescriptorLayout>& layout,
+        const std::string&) {
+        assert(!layout->isBindless());
+        return std::make_shared<NullDescriptorSet>(statistics, layout);
+    }
+
+}
@@ -0,0 +1,220 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.null.resources;
+
+import std;
+import vireo;
+
+export namespace vireo {
+
+    /**
+     * Counters of the null recorder backend
+     */
+    enum class NullCounter : uint8_t {
+        //! Created buffers
+        BUFFERS,
+        //! Total size of the created buffers
+        BUFFER_BYTES,
+        //! Created images, including the images of the render targets
+        IMAGES,
+        //! Total size of the created images
+        IMAGE_BYTES,
+        //! Created render targets
+        RENDER_TARGETS,
+        //! Created samplers
+        SAMPLERS,
+        //! Created descriptor sets
+        DESCRIPTOR_SETS,
+        //! Descriptors written by DescriptorSet::update()
+        DESCRIPTOR_WRITES,
+        //! Created pipelines
+        PIPELINES,
+        //! Created command lists
+        COMMAND_LISTS,
+        //! Commands of the submitted command lists
+        COMMANDS,
+        //! Size of the command streams of the submitted command lists
+        STREAM_BYTES,
+        //! Queue submissions
+        SUBMITS,
+        //! Number of counters
+        COUNT,
+    };
+
+    /**
+     * Objects allocations and commands counters, shared by all the objects of a NullVireo
+     */
+    class NullStatistics {
+    public:
+        void add(const NullCounter counter, const uint64_t value = 1) {
+            counters[static_cast<int>(counter)].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        uint64_t get(const NullCounter counter) const {
+            return counters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+        }
+
+        void reset() {
+            for (auto& counter : counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, static_cast<int>(NullCounter::COUNT)> counters{};
+    };
+
+    class NullInstance : public Instance {
+    public:
+        NullInstance() = default;
+    };
+
+    class NullPhysicalDevice : public PhysicalDevice {
+    public:
+        NullPhysicalDevice() = default;
+
+        PhysicalDeviceDesc getDescription() const override { return { .name = "Null recorder" }; }
+    };
+
+    class NullDevice : public Device {
+    public:
+        NullDevice() = default;
+
+        bool haveDedicatedTransferQueue() const override { return false; }
+    };
+
+    class NullBuffer : public Buffer {
+    public:
+        // Same as the common minUniformBufferOffsetAlignment, to keep the dynamic offsets of the real backends
+        static constexpr size_t UNIFORM_ALIGNMENT{256};
+
+        NullBuffer(
+            const std::shared_ptr<NullStatistics>& statistics,
+            BufferType type,
+            size_t size,
+            size_t count,
+            const std::string& name);
+
+        void map() override;
+
+        void unmap() override;
+
+    private:
+        // Host memory, allocated on the first map()
+        std::vector<std::byte> memory;
+    };
+
+    class NullSampler : public Sampler {
+    public:
+        NullSampler() = default;
+    };
+
+    class NullImage : public Image {
+    public:
+        NullImage(
+            const std::shared_ptr<NullStatistics>& statistics,
+            ImageFormat format,
+            uint32_t width,
+            uint32_t height,
+            uint32_t mipLevels,
+            uint32_t arraySize,
+            bool isReadWrite,
+            const std::string& name);
+    };
+
+    class NullRenderTarget : public RenderTarget {
+    public:
+        NullRenderTarget(RenderTargetType type, const std::shared_ptr<Image>& image) :
+            RenderTarget{type, image} {}
+
+        std::shared_ptr<RenderTarget> fromLayer(uint32_t imageLayer) override;
+    };
+
+    class NullDescriptorLayout : public DescriptorLayout {
+    public:
+        NullDescriptorLayout(const bool samplers, const bool dynamic, const bool bindless = false) :
+            DescriptorLayout{samplers, dynamic, bindless} {}
+
+        DescriptorLayout& add(DescriptorIndex index, DescriptorType type, size_t count = 1) override;
+    };
+
+    class NullDescriptorSet : public DescriptorSet {
+    public:
+        NullDescriptorSet(
+            const std::shared_ptr<NullStatistics>& statistics,
+            const std::shared_ptr<const DescriptorLayout>& layout);
+
+        void update(DescriptorIndex index, const std::shared_ptr<const Buffer>& buffer, bool useWholeSize) override;
+
+        void update(
+            DescriptorIndex index,
+            const std::shared_ptr<const Buffer>& buffer,
+            const std::shared_ptr<const Buffer>& counterBuffer) override;
+
+        void update(DescriptorIndex index, const Buffer& buffer, const Buffer& counterBuffer) override;
+
+        void update(DescriptorIndex index, const Buffer& buffer, bool useWholeSize) override;
+
+        void update(DescriptorIndex index, const Image& image, bool forceShaderRead) override;
+
+        void update(DescriptorIndex index, const Sampler& sampler) override;
+
+        void update(DescriptorIndex index, const std::vector<std::shared_ptr<Image>>& images) override;
+
+        void update(DescriptorIndex index, const std::vector<std::shared_ptr<Buffer>>& buffers) override;
+
+        void update(DescriptorIndex index, const std::vector<std::shared_ptr<Sampler>>& samplers) override;
+
+        void update(const std::vector<DescriptorWrite>& writes) override;
+
+    private:
+        const std::shared_ptr<NullStatistics> statistics;
+    };
+
+    class NullTransientDescriptorAllocator : public TransientDescriptorAllocator {
+    public:
+        NullTransientDescriptorAllocator(const std::shared_ptr<NullStatistics>& statistics) :
+            statistics{statistics} {}
+
+        std::shared_ptr<DescriptorSet> createDescriptorSet(
+            const std::shared_ptr<const DescriptorLayout>& layout,
+            const std::string& name) override;
+
+        void reset() override {}
+
+    private:
+        const std::shared_ptr<NullStatistics> statistics;
+    };
+
+    class NullVertexInputLayout : public VertexInputLayout {
+    public:
+        NullVertexInputLayout() = default;
+    };
+
+    class NullShaderModule : public ShaderModule {
+    public:
+        NullShaderModule() = default;
+    };
+
+    class NullPipelineResources : public PipelineResources {
+    public:
+        NullPipelineResources() = default;
+    };
+
+    class NullComputePipeline : public ComputePipeline {
+    public:
+        NullComputePipeline(const std::shared_ptr<PipelineResources>& pipelineResources) :
+            ComputePipeline{pipelineResources} {}
+    };
+
+    class NullGraphicPipeline : public GraphicPipeline {
+    public:
+        NullGraphicPipeline(const std::shared_ptr<PipelineResources>& pipelineResources) :
+            GraphicPipeline{pipelineResources} {}
+    };
+
+}
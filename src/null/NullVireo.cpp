@@ -0,0 +1,237 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include <cassert>
+module vireo.null;
+
+namespace vireo {
+
+    NullVireo::NullVireo(const BackendConfiguration&) :
+        statistics{std::make_shared<NullStatistics>()} {
+        instance = std::make_shared<NullInstance>();
+        physicalDevice = std::make_shared<NullPhysicalDevice>();
+        device = std::make_shared<NullDevice>();
+    }
+
+    NullVireo::~NullVireo() {
+        stopCompilationThreads();
+    }
+
+    std::shared_ptr<SwapChain> NullVireo::createSwapChain(
+        const ImageFormat format,
+        const std::shared_ptr<SubmitQueue>&,
+        PlatformWindowHandle,
+        const PresentMode presentMode,
+        const uint32_t framesInFlight) const {
+        return std::make_shared<NullSwapChain>(format, presentMode, NullSwapChain::DEFAULT_EXTENT, framesInFlight);
+    }
+
+    std::shared_ptr<SwapChain> NullVireo::createOffscreenSwapChain(
+        const ImageFormat format,
+        const std::shared_ptr<SubmitQueue>&,
+        const Extent& extent,
+        const uint32_t framesInFlight) const {
+        return std::make_shared<NullSwapChain>(format, PresentMode::IMMEDIATE, extent, framesInFlight);
+    }
+
+    std::shared_ptr<SubmitQueue> NullVireo::createSubmitQueue(const CommandType, const std::string&) const {
+        return std::make_shared<NullSubmitQueue>(statistics);
+    }
+
+    std::shared_ptr<Fence> NullVireo::createFence(const bool createSignaled, const std::string&) const {
+        return std::make_shared<NullFence>(createSignaled);
+    }
+
+    std::shared_ptr<Semaphore> NullVireo::createSemaphore(const SemaphoreType type, const std::string&) const {
+        return std::make_shared<Semaphore>(type);
+    }
+
+    std::shared_ptr<CommandAllocator> NullVireo::createCommandAllocator(const CommandType type) const {
+        return std::make_shared<NullCommandAllocator>(statistics, type);
+    }
+
+    std::shared_ptr<VertexInputLayout> NullVireo::createVertexLayout(
+        size_t,
+        const std::vector<VertexAttributeDesc>&) const {
+        return std::make_shared<NullVertexInputLayout>();
+    }
+
+    std::shared_ptr<ShaderModule> NullVireo::createShaderModule(const std::string&) const {
+        // The shader files are not read
+        return std::make_shared<NullShaderModule>();
+    }
+
+    std::shared_ptr<ShaderModule> NullVireo::createShaderModule(
+        const std::vector<char>&,
+        const std::string&) const {
+        return std::make_shared<NullShaderModule>();
+    }
+
+    std::shared_ptr<ShaderModule> NullVireo::createShaderModule(
+        const std::span<const uint32_t>,
+        const std::string&) const {
+        return std::make_shared<NullShaderModule>();
+    }
+
+    std::shared_ptr<PipelineResources> NullVireo::createPipelineResources(
+        const std::vector<std::shared_ptr<DescriptorLayout>>&,
+        const PushConstantsDesc&,
+        const std::string&) const {
+        return std::make_shared<NullPipelineResources>();
+    }
+
+    std::shared_ptr<ComputePipeline> NullVireo::createComputePipeline(
+        const std::shared_ptr<PipelineResources>& pipelineResources,
+        const std::shared_ptr<const ShaderModule>& shader,
+        const std::string&) const {
+        assert(shader != nullptr);
+        statistics->add(NullCounter::PIPELINES);
+        return std::make_shared<NullComputePipeline>(pipelineResources);
+    }
+
+    std::shared_ptr<GraphicPipeline> NullVireo::createGraphicPipeline(
+        const GraphicPipelineConfiguration& configuration,
+        const std::string&) const {
+        assert(configuration.resources != nullptr);
+        statistics->add(NullCounter::PIPELINES);
+        return std::make_shared<NullGraphicPipeline>(configuration.resources);
+    }
+
+    std::shared_ptr<Buffer> NullVireo::createBuffer(
+        const BufferType type,
+        const size_t size,
+        const size_t count,
+        const std::string& name) const {
+        return std::make_shared<NullBuffer>(statistics, type, size, count, name);
+    }
+
+    std::shared_ptr<Image> NullVireo::createImage(
+        const ImageFormat format,
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t mipLevels,
+        const uint32_t arraySize,
+        const std::string& name) const {
+        return std::make_shared<NullImage>(statistics, format, width, height, mipLevels, arraySize, false, name);
+    }
+
+    std::shared_ptr<Image> NullVireo::createReadWriteImage(
+        const ImageFormat format,
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t mipLevels,
+        const uint32_t arraySize,
+        const std::string& name) const {
+        return std::make_shared<NullImage>(statistics, format, width, height, mipLevels, arraySize, true, name);
+    }
+
+    std::shared_ptr<RenderTarget> NullVireo::createRenderTarget(
+        const ImageFormat format,
+        const uint32_t width,
+        const uint32_t height,
+        const RenderTargetType type,
+        const ClearValue,
+        const uint32_t arraySize,
+        const MSAA,
+        const std::string& name) const {
+        statistics->add(NullCounter::RENDER_TARGETS);
+        return std::make_shared<NullRenderTarget>(
+            type,
+            std::make_shared<NullImage>(statistics, format, width, height, 1, arraySize, false, name));
+    }
+
+    std::shared_ptr<RenderTarget> NullVireo::createRenderTarget(
+        const std::shared_ptr<const SwapChain>& swapChain,
+        const ClearValue,
+        const MSAA,
+        const std::string& name) const {
+        statistics->add(NullCounter::RENDER_TARGETS);
+        return std::make_shared<NullRenderTarget>(
+            RenderTargetType::COLOR,
+            std::make_shared<NullImage>(
+                statistics,
+                swapChain->getFormat(),
+                swapChain->getExtent().width,
+                swapChain->getExtent().height,
+                1, 1, false,
+                name));
+    }
+
+    std::shared_ptr<RenderTarget> NullVireo::createRenderTarget(const std::shared_ptr<Image>& image) const {
+        statistics->add(NullCounter::RENDER_TARGETS);
+        return std::make_shared<NullRenderTarget>(RenderTargetType::COLOR, image);
+    }
+
+    std::shared_ptr<DescriptorLayout> NullVireo::createBindlessDescriptorLayout(const std::string&) const {
+        return std::make_shared<NullDescriptorLayout>(false, false, true);
+    }
+
+    std::shared_ptr<DescriptorLayout> NullVireo::createDescriptorLayout(const std::string&) const {
+        return std::make_shared<NullDescriptorLayout>(false, false, false);
+    }
+
+    std::shared_ptr<DescriptorLayout> NullVireo::createSamplerDescriptorLayout(const std::string&) const {
+        return std::make_shared<NullDescriptorLayout>(true, false, false);
+    }
+
+    std::shared_ptr<DescriptorLayout> NullVireo::_createDynamicUniformDescriptorLayout(const std::string&) const {
+        return std::make_shared<NullDescriptorLayout>(false, true, false);
+    }
+
+    std::shared_ptr<DescriptorSet> NullVireo::createDescriptorSet(
+        const std::shared_ptr<const DescriptorLayout>& layout,
+        const std::string&) const {
+        return std::make_shared<NullDescriptorSet>(statistics, layout);
+    }
+
+    std::shared_ptr<TransientDescriptorAllocator> NullVireo::createTransientDescriptorAllocator(
+        const std::string&) const {
+        return std::make_shared<NullTransientDescriptorAllocator>(statistics);
+    }
+
+    std::shared_ptr<Sampler> NullVireo::createSampler(
+        Filter,
+        Filter,
+        AddressMode,
+        AddressMode,
+        AddressMode,
+        float,
+        float,
+        bool,
+        FilterMode,
+        CompareOp) const {
+        statistics->add(NullCounter::SAMPLERS);
+        return std::make_shared<NullSampler>();
+    }
+
+    std::shared_ptr<QueryPool> NullVireo::createQueryPool(const uint32_t capacity, const std::string&) const {
+        return std::make_shared<NullQueryPool>(capacity);
+    }
+
+    MemoryStatistics NullVireo::getMemoryStatistics() const {
+        const auto bytes = statistics->get(NullCounter::BUFFER_BYTES) + statistics->get(NullCounter::IMAGE_BYTES);
+        const auto count = static_cast<uint32_t>(
+            statistics->get(NullCounter::BUFFERS) + statistics->get(NullCounter::IMAGES));
+        return {
+            .heaps = {{
+                .size = bytes,
+                .allocatedBytes = bytes,
+                .usedBytes = bytes,
+                .blockCount = count,
+                .allocationCount = count,
+            }},
+            .types = {{
+                .heapIndex = 0,
+                .allocatedBytes = bytes,
+                .usedBytes = bytes,
+                .blockCount = count,
+                .allocationCount = count,
+            }},
+        };
+    }
+
+}
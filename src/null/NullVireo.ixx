@@ -0,0 +1,179 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+export module vireo.null;
+
+import std;
+import vireo;
+import vireo.null.commands;
+import vireo.null.resources;
+
+export namespace vireo {
+
+    /**
+     * Backend without GPU : objects are created in host memory, commands are recorded in compact streams and
+     * submissions complete immediately. Used to measure the CPU cost of the API calls.
+     *
+     * Manual page : \ref manual_010_vireo_class
+     */
+    class NullVireo : public Vireo {
+    public:
+        NullVireo(const BackendConfiguration& config);
+
+        ~NullVireo() override;
+
+        std::shared_ptr<SwapChain> createSwapChain(
+            ImageFormat format,
+            const std::shared_ptr<SubmitQueue>& submitQueue,
+            PlatformWindowHandle windowHandle,
+            PresentMode presentMode,
+            uint32_t framesInFlight) const override;
+
+        std::shared_ptr<SwapChain> createOffscreenSwapChain(
+            ImageFormat format,
+            const std::shared_ptr<SubmitQueue>& presentQueue,
+            const Extent& extent,
+            uint32_t framesInFlight) const override;
+
+        std::shared_ptr<SubmitQueue> createSubmitQueue(
+            CommandType commandType,
+            const std::string& name) const override;
+
+        std::shared_ptr<Fence> createFence(
+            bool createSignaled,
+            const std::string& name) const override;
+
+        std::shared_ptr<Semaphore> createSemaphore(
+            SemaphoreType type,
+            const std::string& name) const override;
+
+        std::shared_ptr<CommandAllocator> createCommandAllocator(CommandType type) const override;
+
+        std::shared_ptr<VertexInputLayout> createVertexLayout(
+            size_t size,
+            const std::vector<VertexAttributeDesc>& attributesDescriptions) const override;
+
+        std::shared_ptr<ShaderModule> createShaderModule(const std::string& fileName) const override;
+
+        std::shared_ptr<ShaderModule> createShaderModule(
+            const std::vector<char>& data,
+            const std::string& name) const override;
+
+        std::shared_ptr<ShaderModule> createShaderModule(
+            std::span<const uint32_t> code,
+            const std::string& name) const override;
+
+        std::shared_ptr<PipelineResources> createPipelineResources(
+            const std::vector<std::shared_ptr<DescriptorLayout>>& descriptorLayouts,
+            const PushConstantsDesc& pushConstant,
+            const std::string& name) const override;
+
+        std::shared_ptr<ComputePipeline> createComputePipeline(
+            const std::shared_ptr<PipelineResources>& pipelineResources,
+            const std::shared_ptr<const ShaderModule>& shader,
+            const std::string& name) const override;
+
+        std::shared_ptr<GraphicPipeline> createGraphicPipeline(
+            const GraphicPipelineConfiguration& configuration,
+            const std::string& name) const override;
+
+        std::shared_ptr<Buffer> createBuffer(
+            BufferType type,
+            size_t size,
+            size_t count,
+            const std::string& name) const override;
+
+        std::shared_ptr<Image> createImage(
+            ImageFormat format,
+            uint32_t width,
+            uint32_t height,
+            uint32_t mipLevels,
+            uint32_t arraySize,
+            const std::string& name) const override;
+
+        std::shared_ptr<Image> createReadWriteImage(
+            ImageFormat format,
+            uint32_t width,
+            uint32_t height,
+            uint32_t mipLevels,
+            uint32_t arraySize,
+            const std::string& name) const override;
+
+        std::shared_ptr<RenderTarget> createRenderTarget(
+            ImageFormat format,
+            uint32_t width,
+            uint32_t height,
+            RenderTargetType type,
+            ClearValue clearValue,
+            uint32_t arraySize,
+            MSAA msaa,
+            const std::string& name) const override;
+
+        std::shared_ptr<RenderTarget> createRenderTarget(
+            const std::shared_ptr<const SwapChain>& swapChain,
+            ClearValue clearValue,
+            MSAA msaa,
+            const std::string& name) const override;
+
+        std::shared_ptr<RenderTarget> createRenderTarget(
+            const std::shared_ptr<Image>& image) const override;
+
+        std::shared_ptr<DescriptorLayout> createBindlessDescriptorLayout(
+            const std::string& name) const override;
+
+        std::shared_ptr<DescriptorLayout> createDescriptorLayout(
+            const std::string& name) const override;
+
+        std::shared_ptr<DescriptorLayout> createSamplerDescriptorLayout(
+            const std::string& name) const override;
+
+        std::shared_ptr<DescriptorLayout> _createDynamicUniformDescriptorLayout(
+            const std::string& name) const override;
+
+        std::shared_ptr<DescriptorSet> createDescriptorSet(
+            const std::shared_ptr<const DescriptorLayout>& layout,
+            const std::string& name) const override;
+
+        std::shared_ptr<TransientDescriptorAllocator> createTransientDescriptorAllocator(
+            const std::string& name) const override;
+
+        std::shared_ptr<Sampler> createSampler(
+            Filter minFilter,
+            Filter magFilter,
+            AddressMode addressModeU,
+            AddressMode addressModeV,
+            AddressMode addressModeW,
+            float minLod,
+            float maxLod,
+            bool anisotropyEnable,
+            FilterMode mipMapMode,
+            CompareOp compareOp) const override;
+
+        std::shared_ptr<QueryPool> createQueryPool(
+            uint32_t capacity,
+            const std::string& name) const override;
+
+        constexpr std::string getShaderFileExtension() const override {
+            return ".spv";
+        }
+
+        constexpr Backend getBackend() const override {
+            return Backend::NULL_RECORDER;
+        }
+
+        // One host heap with the size of all the buffers and images created
+        MemoryStatistics getMemoryStatistics() const override;
+
+        /**
+         * Returns the counters of the objects created and of the submitted commands
+         */
+        auto& getStatistics() const { return *statistics; }
+
+    private:
+        const std::shared_ptr<NullStatistics> statistics;
+    };
+
+}
@@ -6,10 +6,12 @@
 */
 module;
 #include "vireo/backend/vulkan/Libraries.h"
+#include <cstring>
 #include <cassert>
 module vireo.vulkan.commands;
 
 import std;
+import vireo.profiler;
 import vireo.tools;
 import vireo.vulkan.descriptors;
 import vireo.vulkan.pipelines;
@@ -29,6 +31,11 @@ namespace vireo {
             device->getGraphicsQueueFamilyIndex(),
             0,
             &commandQueue);
+        pendingSubmissions.reserve(PENDING_SUBMISSIONS);
+        submitInfos.reserve(PENDING_SUBMISSIONS);
+        pendingCommandBuffers.reserve(PENDING_COMMAND_BUFFERS);
+        pendingWaits.reserve(PENDING_SEMAPHORES);
+        pendingSignals.reserve(PENDING_SEMAPHORES);
 #ifdef _DEBUG
         vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(commandQueue), VK_OBJECT_TYPE_QUEUE,
             "VKSubmitQueue : " + name);
@@ -37,9 +44,81 @@ namespace vireo {
 
     void VKSubmitQueue::waitIdle() const {
         auto lock = std::lock_guard{submitMutex};
+        flush();
         vkQueueWaitIdle(commandQueue);
     }
 
+    void VKSubmitQueue::setDeferred(const bool deferred) {
+        auto lock = std::lock_guard{submitMutex};
+        if (!deferred) {
+            flush();
+        }
+        this->deferred = deferred;
+    }
+
+    void VKSubmitQueue::addSubmission(
+        const uint32_t waitCount,
+        const std::vector<std::shared_ptr<const CommandList>>& commandLists,
+        const VkSemaphoreSubmitInfo* signal,
+        const VkFence fence) const {
+        const auto zone = CPUProfiler::Zone{"VKSubmitQueue::submit"};
+        for (const auto& commandList : commandLists) {
+            pendingCommandBuffers.push_back({
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+                .commandBuffer = static_pointer_cast<const VKCommandList>(commandList)->getCommandBuffer(),
+            });
+        }
+        if (signal) {
+            pendingSignals.push_back(*signal);
+        }
+        pendingSubmissions.push_back({
+            .waitCount = waitCount,
+            .commandBufferCount = static_cast<uint32_t>(commandLists.size()),
+            .signalCount = signal ? 1u : 0u,
+            .fence = fence,
+        });
+        if (!deferred) {
+            flush();
+        }
+    }
+
+    void VKSubmitQueue::flush() const {
+        const auto zone = CPUProfiler::Zone{"VKSubmitQueue::flush"};
+        auto lock = std::lock_guard{submitMutex};
+        if (pendingSubmissions.empty()) { return; }
+        auto wait = pendingWaits.data();
+        auto commandBuffer = pendingCommandBuffers.data();
+        auto signal = pendingSignals.data();
+        for (const auto& submission : pendingSubmissions) {
+            submitInfos.push_back({
+                .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+                .waitSemaphoreInfoCount   = submission.waitCount,
+                .pWaitSemaphoreInfos      = submission.waitCount > 0 ? wait : nullptr,
+                .commandBufferInfoCount   = submission.commandBufferCount,
+                .pCommandBufferInfos      = submission.commandBufferCount > 0 ? commandBuffer : nullptr,
+                .signalSemaphoreInfoCount = submission.signalCount,
+                .pSignalSemaphoreInfos    = submission.signalCount > 0 ? signal : nullptr,
+            });
+            wait += submission.waitCount;
+            commandBuffer += submission.commandBufferCount;
+            signal += submission.signalCount;
+            // A fence is signaled once all the batches of its vkQueueSubmit2 call have completed :
+            // the batches following a fenced submission go in the next call
+            if (submission.fence != VK_NULL_HANDLE) {
+                vkCheck(vkQueueSubmit2(commandQueue, submitInfos.size(), submitInfos.data(), submission.fence));
+                submitInfos.clear();
+            }
+        }
+        if (!submitInfos.empty()) {
+            vkCheck(vkQueueSubmit2(commandQueue, submitInfos.size(), submitInfos.data(), VK_NULL_HANDLE));
+            submitInfos.clear();
+        }
+        pendingSubmissions.clear();
+        pendingWaits.clear();
+        pendingCommandBuffers.clear();
+        pendingSignals.clear();
+    }
+
     void VKSubmitQueue::submit(
         const std::shared_ptr<Fence>& fence,
         const std::shared_ptr<const SwapChain>& swapChain,
@@ -49,44 +128,19 @@ namespace vireo {
         assert(!commandLists.empty());
         const auto vkSwapChain = static_pointer_cast<const VKSwapChain>(swapChain);
         const auto vkFence = static_pointer_cast<const VKFence>(fence);
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-        const auto submitInfo = VkSubmitInfo2  {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount   = 1,
-            .pWaitSemaphoreInfos      = &vkSwapChain->getCurrentImageAvailableSemaphoreInfo(),
-            .commandBufferInfoCount   = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos      = submitInfos.data(),
-            .signalSemaphoreInfoCount = 1,
-            .pSignalSemaphoreInfos    = &vkSwapChain->getCurrentRenderFinishedSemaphoreInfo()
-        };
         auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, vkFence->getFence()));
+        pendingWaits.push_back(vkSwapChain->getCurrentImageAvailableSemaphoreInfo());
+        addSubmission(
+            1,
+            commandLists,
+            &vkSwapChain->getCurrentRenderFinishedSemaphoreInfo(),
+            vkFence->getFence());
     }
 
     void VKSubmitQueue::submit(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
         assert(!commandLists.empty());
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-        const auto submitInfo = VkSubmitInfo2 {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount   = 0,
-            .commandBufferInfoCount   = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos      = submitInfos.data(),
-            .signalSemaphoreInfoCount = 0,
-        };
         auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, VK_NULL_HANDLE));
+        addSubmission(0, commandLists, nullptr, VK_NULL_HANDLE);
     }
 
     void VKSubmitQueue::submit(
@@ -94,27 +148,8 @@ namespace vireo {
         const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
         assert(fence != nullptr);
         const auto vkFence = static_pointer_cast<const VKFence>(fence);
-        if (commandLists.empty()) {
-            auto lock = std::lock_guard{submitMutex};
-            vkCheck(vkQueueSubmit2(commandQueue, 0, nullptr, vkFence->getFence()));
-            return;
-        }
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-        const auto submitInfo = VkSubmitInfo2 {
-            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount = 0,
-            .commandBufferInfoCount = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos = submitInfos.data(),
-            .signalSemaphoreInfoCount = 0,
-        };
         auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, vkFence->getFence()));
+        addSubmission(0, commandLists, nullptr, vkFence->getFence());
     }
 
     void VKSubmitQueue::submit(
@@ -127,20 +162,14 @@ namespace vireo {
         assert(!commandLists.empty());
         const auto vkWaitSemaphore = static_pointer_cast<VKSemaphore>(waitSemaphore);
         const auto vkSignalSemaphore = static_pointer_cast<VKSemaphore>(signalSemaphore);
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-        auto waitSemaphoreSubmitInfo = VkSemaphoreSubmitInfo{
-            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO
-        };
+        auto lock = std::lock_guard{submitMutex};
         if (vkWaitSemaphore) {
-            waitSemaphoreSubmitInfo.semaphore = vkWaitSemaphore->getSemaphore();
-            waitSemaphoreSubmitInfo.stageMask = static_cast<VkPipelineStageFlags2>(waitStage);
-            waitSemaphoreSubmitInfo.value = vkWaitSemaphore->getValue();
+            pendingWaits.push_back({
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .semaphore = vkWaitSemaphore->getSemaphore(),
+                .value = vkWaitSemaphore->getValue(),
+                .stageMask = static_cast<VkPipelineStageFlags2>(waitStage),
+            });
         }
         auto signalSemaphoreSubmitInfo = VkSemaphoreSubmitInfo{
             .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO
@@ -153,17 +182,11 @@ namespace vireo {
             signalSemaphoreSubmitInfo.stageMask = static_cast<VkPipelineStageFlags2>(signalStage);
             signalSemaphoreSubmitInfo.value = vkSignalSemaphore->getValue();
         }
-        const auto submitInfo = VkSubmitInfo2 {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount   = waitSemaphore ? 1u : 0u,
-            .pWaitSemaphoreInfos      = waitSemaphore ? &waitSemaphoreSubmitInfo : VK_NULL_HANDLE,
-            .commandBufferInfoCount   = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos      = submitInfos.data(),
-            .signalSemaphoreInfoCount = signalSemaphore ? 1u : 0u,
-            .pSignalSemaphoreInfos    = signalSemaphore ? &signalSemaphoreSubmitInfo : VK_NULL_HANDLE,
-        };
-        auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, VK_NULL_HANDLE));
+        addSubmission(
+            vkWaitSemaphore ? 1u : 0u,
+            commandLists,
+            vkSignalSemaphore ? &signalSemaphoreSubmitInfo : nullptr,
+            VK_NULL_HANDLE);
     }
 
     void VKSubmitQueue::submit(
@@ -176,22 +199,17 @@ namespace vireo {
         assert(!commandLists.empty());
         const auto vkWaitSemaphore = static_pointer_cast<VKSemaphore>(waitSemaphore);
         const auto vkSignalSemaphore = static_pointer_cast<VKSemaphore>(signalSemaphore);
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-        std::vector<VkSemaphoreSubmitInfo> waitSemaphoreSubmitInfos(waitStages.size());
+        auto lock = std::lock_guard{submitMutex};
         if (vkWaitSemaphore) {
             assert(waitSemaphore->getType() == SemaphoreType::TIMELINE);
             assert(waitStages.size() > 0);
             for (int i = 0; i < waitStages.size(); i++) {
-                waitSemaphoreSubmitInfos[i].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-                waitSemaphoreSubmitInfos[i].semaphore = vkWaitSemaphore->getSemaphore();
-                waitSemaphoreSubmitInfos[i].stageMask = static_cast<VkPipelineStageFlags2>(waitStages[i]);
-                waitSemaphoreSubmitInfos[i].value = vkWaitSemaphore->getValue() + i;
+                pendingWaits.push_back({
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                    .semaphore = vkWaitSemaphore->getSemaphore(),
+                    .value = vkWaitSemaphore->getValue() + i,
+                    .stageMask = static_cast<VkPipelineStageFlags2>(waitStages[i]),
+                });
             }
         }
         auto signalSemaphoreSubmitInfo = VkSemaphoreSubmitInfo{
@@ -205,20 +223,13 @@ namespace vireo {
             signalSemaphoreSubmitInfo.stageMask = static_cast<VkPipelineStageFlags2>(signalStage);
             signalSemaphoreSubmitInfo.value = vkSignalSemaphore->getValue();
         }
-        const auto submitInfo = VkSubmitInfo2 {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount   = waitSemaphore ? static_cast<uint32_t>(waitSemaphoreSubmitInfos.size()) : 0u,
-            .pWaitSemaphoreInfos      = waitSemaphore ? waitSemaphoreSubmitInfos.data() : VK_NULL_HANDLE,
-            .commandBufferInfoCount   = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos      = submitInfos.data(),
-            .signalSemaphoreInfoCount = signalSemaphore ? 1u : 0u,
-            .pSignalSemaphoreInfos    = signalSemaphore ? &signalSemaphoreSubmitInfo : VK_NULL_HANDLE,
-        };
-        auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, VK_NULL_HANDLE));
+        addSubmission(
+            vkWaitSemaphore ? static_cast<uint32_t>(waitStages.size()) : 0u,
+            commandLists,
+            vkSignalSemaphore ? &signalSemaphoreSubmitInfo : nullptr,
+            VK_NULL_HANDLE);
     }
 
-
     void VKSubmitQueue::submit(
            const std::shared_ptr<Semaphore>& waitSemaphore,
            WaitStage waitStage,
@@ -232,37 +243,21 @@ namespace vireo {
         const auto vkSwapChain = static_pointer_cast<const VKSwapChain>(swapChain);
         const auto vkFence = static_pointer_cast<const VKFence>(fence);
         const auto vkWaitSemaphore = static_pointer_cast<VKSemaphore>(waitSemaphore);
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-
-        auto waitSubmitInfos = std::vector {
-            vkSwapChain->getCurrentImageAvailableSemaphoreInfo()
-        };
+        auto lock = std::lock_guard{submitMutex};
+        pendingWaits.push_back(vkSwapChain->getCurrentImageAvailableSemaphoreInfo());
         if (vkWaitSemaphore) {
-            waitSubmitInfos.push_back(VkSemaphoreSubmitInfo{
+            pendingWaits.push_back({
                 .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
                 .semaphore = vkWaitSemaphore->getSemaphore(),
                 .value = vkWaitSemaphore->getValue(),
                 .stageMask = static_cast<VkPipelineStageFlags2>(waitStage),
             });
         }
-
-        const auto submitInfo = VkSubmitInfo2 {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount   = static_cast<uint32_t>(waitSubmitInfos.size()),
-            .pWaitSemaphoreInfos      = waitSubmitInfos.data(),
-            .commandBufferInfoCount   = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos      = submitInfos.data(),
-            .signalSemaphoreInfoCount = 1,
-            .pSignalSemaphoreInfos    = &vkSwapChain->getCurrentRenderFinishedSemaphoreInfo(),
-        };
-        auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, vkFence->getFence()));
+        addSubmission(
+            vkWaitSemaphore ? 2u : 1u,
+            commandLists,
+            &vkSwapChain->getCurrentRenderFinishedSemaphoreInfo(),
+            vkFence->getFence());
     }
 
     void VKSubmitQueue::submit(
@@ -278,23 +273,13 @@ namespace vireo {
         const auto vkSwapChain = static_pointer_cast<const VKSwapChain>(swapChain);
         const auto vkFence = static_pointer_cast<const VKFence>(fence);
         const auto vkWaitSemaphore = static_pointer_cast<VKSemaphore>(waitSemaphore);
-        auto submitInfos = std::vector<VkCommandBufferSubmitInfo>(commandLists.size());
-        for (int i = 0; i < commandLists.size(); i++) {
-            submitInfos[i] = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                .commandBuffer = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer(),
-            };
-        }
-
-        auto waitSubmitInfos = std::vector {
-            vkSwapChain->getCurrentImageAvailableSemaphoreInfo()
-        };
-        std::vector<VkSemaphoreSubmitInfo> waitSemaphoreSubmitInfos(waitStages.size());
+        auto lock = std::lock_guard{submitMutex};
+        pendingWaits.push_back(vkSwapChain->getCurrentImageAvailableSemaphoreInfo());
         if (vkWaitSemaphore) {
             assert(waitSemaphore->getType() == SemaphoreType::TIMELINE);
             assert(waitStages.size() > 0);
             for (int i = 0; i < waitStages.size(); i++) {
-                waitSubmitInfos.push_back(VkSemaphoreSubmitInfo{
+                pendingWaits.push_back({
                     .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
                     .semaphore = vkWaitSemaphore->getSemaphore(),
                     .value = vkWaitSemaphore->getValue() + i,
@@ -302,18 +287,11 @@ namespace vireo {
                 });
             }
         }
-
-        const auto submitInfo = VkSubmitInfo2 {
-            .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount   = static_cast<uint32_t>(waitSubmitInfos.size()),
-            .pWaitSemaphoreInfos      = waitSubmitInfos.data(),
-            .commandBufferInfoCount   = static_cast<uint32_t>(submitInfos.size()),
-            .pCommandBufferInfos      = submitInfos.data(),
-            .signalSemaphoreInfoCount = 1,
-            .pSignalSemaphoreInfos    = &vkSwapChain->getCurrentRenderFinishedSemaphoreInfo(),
-        };
-        auto lock = std::lock_guard{submitMutex};
-        vkCheck(vkQueueSubmit2(commandQueue, 1, &submitInfo, vkFence->getFence()));
+        addSubmission(
+            1 + (vkWaitSemaphore ? static_cast<uint32_t>(waitStages.size()) : 0u),
+            commandLists,
+            &vkSwapChain->getCurrentRenderFinishedSemaphoreInfo(),
+            vkFence->getFence());
     }
 
     VKCommandAllocator::VKCommandAllocator(const std::shared_ptr<const VKDevice>& device, const CommandType type):
@@ -321,7 +299,8 @@ namespace vireo {
         device{device} {
         const auto poolInfo = VkCommandPoolCreateInfo {
             .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
-            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, // TODO optional
+            // Command buffers are only reset with the pool
+            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
             .queueFamilyIndex =
                 type == CommandType::COMPUTE ? device->getComputeQueueFamilyIndex() :
                 type == CommandType::TRANSFER ?  device->getTransferQueueFamilyIndex() :
@@ -332,6 +311,12 @@ namespace vireo {
 
     void VKCommandAllocator::reset() const {
         vkResetCommandPool(device->getDevice(), commandPool, 0);
+        // The command buffers of the released command lists are now in the initial state
+        auto lock = std::lock_guard{commandListsMutex};
+        for (int level = 0; level < 2; level++) {
+            std::ranges::move(releasedCommandLists[level], std::back_inserter(freeCommandLists[level]));
+            releasedCommandLists[level].clear();
+        }
     }
 
     VKCommandAllocator::~VKCommandAllocator() {
@@ -343,15 +328,56 @@ namespace vireo {
     }
 
     std::shared_ptr<CommandList> VKCommandAllocator::createCommandList() const {
-        return std::make_shared<VKCommandList>(device, commandPool);
+        return getCommandList(false);
     }
 
-    VKCommandList::VKCommandList(const std::shared_ptr<const VKDevice>& device, const VkCommandPool commandPool) :
-        device{device} {
+    std::shared_ptr<CommandList> VKCommandAllocator::createSecondaryCommandList() const {
+        if (getCommandListType() != CommandType::GRAPHIC) {
+            throw Exception("Secondary command lists are only supported for graphic command allocators");
+        }
+        return getCommandList(true);
+    }
+
+    std::shared_ptr<CommandList> VKCommandAllocator::getCommandList(const bool secondary) const {
+        auto commandList = std::unique_ptr<VKCommandList>{};
+        {
+            auto lock = std::lock_guard{commandListsMutex};
+            auto& freeList = freeCommandLists[secondary];
+            if (!freeList.empty()) {
+                commandList = std::move(freeList.back());
+                freeList.pop_back();
+            }
+        }
+        if (commandList == nullptr) {
+            commandList = std::make_unique<VKCommandList>(device, commandPool, secondary);
+        }
+        // The command list goes back to the allocator when released by the user, or is destroyed if the
+        // allocator has been destroyed before
+        return {commandList.release(), [allocator = weak_from_this()](VKCommandList* released) {
+            if (const auto owner = allocator.lock()) {
+                static_cast<const VKCommandAllocator*>(owner.get())->recycle(released);
+            } else {
+                delete released;
+            }
+        }};
+    }
+
+    void VKCommandAllocator::recycle(VKCommandList* commandList) const {
+        commandList->cleanup();
+        auto lock = std::lock_guard{commandListsMutex};
+        releasedCommandLists[commandList->isSecondary()].emplace_back(commandList);
+    }
+
+    VKCommandList::VKCommandList(
+        const std::shared_ptr<const VKDevice>& device,
+        const VkCommandPool commandPool,
+        const bool secondary) :
+        device{device},
+        secondary{secondary} {
         const auto allocInfo = VkCommandBufferAllocateInfo {
             .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
             .commandPool        = commandPool,
-            .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .level              = secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY,
             .commandBufferCount = 1,
         };
         vkCheck(vkAllocateCommandBuffers(device->getDevice(), &allocInfo, &commandBuffer));
@@ -475,6 +501,18 @@ namespace vireo {
         const uint32_t firstSet) const {
         assert(!descriptors.empty());
         const auto vkLayout = static_pointer_cast<const VKPipelineResources>(pipelineResources)->getPipelineLayout();
+        if (device->getDescriptorHeap()) {
+            auto vkDescriptorSets = std::vector<const VKDescriptorSet*>(descriptors.size());
+            for (int i = 0; i < descriptors.size(); i++) {
+                vkDescriptorSets[i] = static_cast<const VKDescriptorSet*>(descriptors[i].get());
+            }
+            setDescriptorBufferOffsets(
+                pipelineType == PipelineType::COMPUTE ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS,
+                vkLayout,
+                firstSet,
+                vkDescriptorSets);
+            return;
+        }
         std::vector<VkDescriptorSet> descriptorSets(descriptors.size());
         for (int i = 0; i < descriptors.size(); i++) {
             descriptorSets[i] = static_pointer_cast<const VKDescriptorSet>(descriptors[i])->getSet();
@@ -497,6 +535,20 @@ namespace vireo {
         assert(!descriptors.empty());
         assert(currentlyBoundPipeline != nullptr);
         const auto vkLayout = static_pointer_cast<const VKPipelineResources>(currentlyBoundPipeline->getResources())->getPipelineLayout();
+        if (device->getDescriptorHeap()) {
+            auto vkDescriptorSets = std::vector<const VKDescriptorSet*>(descriptors.size());
+            for (int i = 0; i < descriptors.size(); i++) {
+                vkDescriptorSets[i] = static_cast<const VKDescriptorSet*>(descriptors[i].get());
+            }
+            setDescriptorBufferOffsets(
+                currentlyBoundPipeline->getType() == PipelineType::COMPUTE ?
+                    VK_PIPELINE_BIND_POINT_COMPUTE :
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                vkLayout,
+                firstSet,
+                vkDescriptorSets);
+            return;
+        }
         std::vector<VkDescriptorSet> descriptorSets(descriptors.size());
         for (int i = 0; i < descriptors.size(); i++) {
             descriptorSets[i] = static_pointer_cast<const VKDescriptorSet>(descriptors[i])->getSet();
@@ -518,6 +570,16 @@ namespace vireo {
         const uint32_t set) const {
         assert(currentlyBoundPipeline != nullptr);
         const auto vkLayout = static_pointer_cast<const VKPipelineResources>(currentlyBoundPipeline->getResources())->getPipelineLayout();
+        if (device->getDescriptorHeap()) {
+            setDescriptorBufferOffsets(
+                currentlyBoundPipeline->getType() == PipelineType::COMPUTE ?
+                    VK_PIPELINE_BIND_POINT_COMPUTE :
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                vkLayout,
+                set,
+                { static_cast<const VKDescriptorSet*>(&descriptor) });
+            return;
+        }
         const auto& descriptorSet = static_cast<const VKDescriptorSet&>(descriptor).getSet();
         vkCmdBindDescriptorSets(commandBuffer,
                                 currentlyBoundPipeline->getType() == PipelineType::COMPUTE ?
@@ -538,6 +600,17 @@ namespace vireo {
         assert(descriptor.getLayout()->isDynamicUniform());
         assert(currentlyBoundPipeline != nullptr);
         const auto vkLayout = static_pointer_cast<const VKPipelineResources>(currentlyBoundPipeline->getResources())->getPipelineLayout();
+        if (device->getDescriptorHeap()) {
+            setDescriptorBufferOffsets(
+                currentlyBoundPipeline->getType() == PipelineType::COMPUTE ?
+                    VK_PIPELINE_BIND_POINT_COMPUTE :
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                vkLayout,
+                set,
+                { static_cast<const VKDescriptorSet*>(&descriptor) },
+                offset);
+            return;
+        }
         const auto& descriptorSet = static_cast<const VKDescriptorSet&>(descriptor).getSet();
         vkCmdBindDescriptorSets(commandBuffer,
                                 currentlyBoundPipeline->getType() == PipelineType::COMPUTE ?
@@ -551,6 +624,36 @@ namespace vireo {
                                 &offset);
     }
 
+    void VKCommandList::setDescriptorBufferOffsets(
+        const VkPipelineBindPoint bindPoint,
+        const VkPipelineLayout pipelineLayout,
+        const uint32_t firstSet,
+        const std::vector<const VKDescriptorSet*>& descriptorSets,
+        const uint32_t dynamicOffset) const {
+        const auto* descriptorHeap = device->getDescriptorHeap();
+        if (!descriptorBuffersBound) {
+            vkCmdBindDescriptorBuffersEXT(
+                commandBuffer,
+                static_cast<uint32_t>(descriptorHeap->getBindingInfos().size()),
+                descriptorHeap->getBindingInfos().data());
+            descriptorBuffersBound = true;
+        }
+        auto bufferIndices = std::vector<uint32_t>(descriptorSets.size());
+        auto offsets = std::vector<VkDeviceSize>(descriptorSets.size());
+        for (int i = 0; i < descriptorSets.size(); i++) {
+            bufferIndices[i] = descriptorSets[i]->getBufferIndex();
+            offsets[i] = descriptorSets[i]->getBufferOffset(dynamicOffset);
+        }
+        vkCmdSetDescriptorBufferOffsetsEXT(
+            commandBuffer,
+            bindPoint,
+            pipelineLayout,
+            firstSet,
+            static_cast<uint32_t>(descriptorSets.size()),
+            bufferIndices.data(),
+            offsets.data());
+    }
+
     void VKCommandList::setStencilReference(const uint32_t reference) const {
         vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, reference);
     }
@@ -600,6 +703,10 @@ namespace vireo {
 
     void VKCommandList::beginRendering(const RenderingConfiguration& conf) {
         uint32_t width{0}, height{0};
+        renderingColorFormats.resize(conf.colorRenderTargets.size());
+        renderingDepthFormat = VK_FORMAT_UNDEFINED;
+        renderingStencilFormat = VK_FORMAT_UNDEFINED;
+        renderingSampleCount = VK_SAMPLE_COUNT_1_BIT;
         const auto vkDepthImage =
             conf.depthStencilRenderTarget ? static_pointer_cast<VKImage>(conf.depthStencilRenderTarget->getImage()) : nullptr;
         auto depthAttachmentInfo = VkRenderingAttachmentInfo {};
@@ -627,6 +734,7 @@ namespace vireo {
                 static_pointer_cast<VKImage>(conf.multisampledDepthStencilRenderTarget->getImage()) :
                 VK_NULL_HANDLE;
             if (msaaDepth) {
+                renderingSampleCount = msaaDepth->getSampleCount();
                 dsAttachmentInfo.imageView = msaaDepth->getImageView();
                 dsAttachmentInfo.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
                 dsAttachmentInfo.resolveImageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
@@ -635,11 +743,14 @@ namespace vireo {
                 dsAttachmentInfo.imageView   = vkDepthImage->getImageView();
             }
 
+            const auto depthFormat = VKImage::vkFormats[static_cast<int>(vkDepthImage->getFormat())];
             if (conf.useDepthAttachment) {
                 depthAttachmentInfo = dsAttachmentInfo;
+                renderingDepthFormat = depthFormat;
             }
             if (conf.useStencilAttachment) {
                 stencilAttachmentInfo = dsAttachmentInfo;
+                renderingStencilFormat = depthFormat;
             }
         }
 
@@ -657,6 +768,10 @@ namespace vireo {
                 rt ? rt->getImageView() ? rt->getImageView() :
                 vkColorImage->getImageView() :
                 VK_NULL_HANDLE;
+            renderingColorFormats[i] =
+                vkSwapChain ? vkSwapChain->getImageFormat() :
+                vkColorImage ? VKImage::vkFormats[static_cast<int>(vkColorImage->getFormat())] :
+                VK_FORMAT_UNDEFINED;
 
             if (colorImageView) {
                 colorAttachmentsInfo[i].sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
@@ -686,6 +801,7 @@ namespace vireo {
                     ResourceState::RENDER_TARGET_COLOR,
                     false, false,
                     0, 1, 0, Image::ALL_LAYERS);
+                renderingSampleCount = msaaColor->getSampleCount();
                 colorAttachmentsInfo[i].imageView = msaaColor->getImageView(),
                 colorAttachmentsInfo[i].resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
                 colorAttachmentsInfo[i].resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
@@ -697,6 +813,8 @@ namespace vireo {
         const auto renderingInfo = VkRenderingInfo {
             .sType               = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
             .pNext                = nullptr,
+            .flags                = conf.secondaryCommandLists ?
+                static_cast<VkRenderingFlags>(VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT) : 0,
             .renderArea           = {
                 {0, 0},
                 {width, height}
@@ -811,376 +929,154 @@ namespace vireo {
             barriers.data());
     }
 
+    // Synchronization scope of a resource state. A transition combines the scope of the old state (source) with
+    // the scope of the new state (destination), so any pair of states is supported.
+    // Only writes need to be made available : the read-only states have no source access.
+    struct VKStateScope {
+        VkPipelineStageFlags stage;
+        VkAccessFlags        srcAccess;
+        VkAccessFlags        dstAccess;
+        VkImageLayout        layout;
+        VkImageAspectFlags   aspect; // 0 : keep the aspect of the image format
+    };
+
+    constexpr auto DEPTH_STAGES =
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    constexpr auto GRAPHIC_SHADER_STAGES =
+        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    constexpr auto DEPTH_STENCIL_ASPECT =
+        VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+
+    // Indexed by ResourceState
+    constexpr auto stateScopes = std::array {
+        // UNDEFINED
+        VKStateScope{
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            0,
+            0,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            0 },
+        // RENDER_TARGET_COLOR
+        VKStateScope{
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            0 },
+        // RENDER_TARGET_DEPTH
+        VKStateScope{
+            DEPTH_STAGES,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            VK_IMAGE_ASPECT_DEPTH_BIT },
+        // RENDER_TARGET_DEPTH_READ
+        VKStateScope{
+            DEPTH_STAGES,
+            0,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+            VK_IMAGE_ASPECT_DEPTH_BIT },
+        // RENDER_TARGET_DEPTH_STENCIL
+        VKStateScope{
+            DEPTH_STAGES,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            DEPTH_STENCIL_ASPECT },
+        // RENDER_TARGET_DEPTH_STENCIL_READ
+        VKStateScope{
+            DEPTH_STAGES,
+            0,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+            DEPTH_STENCIL_ASPECT },
+        // PRESENT
+        VKStateScope{
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0,
+            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            0 },
+        // COPY_SRC
+        VKStateScope{
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            0 },
+        // COPY_DST
+        VKStateScope{
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            0 },
+        // SHADER_READ
+        VKStateScope{
+            GRAPHIC_SHADER_STAGES,
+            0,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            0 },
+        // COMPUTE_READ
+        VKStateScope{
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            0 },
+        // COMPUTE_WRITE
+        VKStateScope{
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL,
+            0 },
+        // INDIRECT_DRAW
+        VKStateScope{
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            0,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL,
+            0 },
+        // VERTEX_INPUT
+        VKStateScope{
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+            0,
+            VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL,
+            0 },
+        // UNIFORM
+        VKStateScope{
+            GRAPHIC_SHADER_STAGES | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            VK_ACCESS_UNIFORM_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL,
+            0 },
+    };
+    static_assert(stateScopes.size() == std::to_underlying(ResourceState::UNIFORM) + 1);
+
     void VKCommandList::convertState(
-            const ResourceState oldState,
-            const ResourceState newState,
-            VkPipelineStageFlags& srcStage,
-            VkPipelineStageFlags& dstStage,
-            VkAccessFlags& srcAccess,
-            VkAccessFlags& dstAccess,
-            VkImageLayout& srcLayout,
-            VkImageLayout& dstLayout,
-            VkImageAspectFlagBits& aspectFlag) {
-        if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_GENERAL;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_GENERAL;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_GENERAL;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_GENERAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_GENERAL;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        } else if (oldState == ResourceState::UNDEFINED &&
-                  (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL || newState == ResourceState::RENDER_TARGET_DEPTH)) {
-            srcStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            aspectFlag = newState == ResourceState::RENDER_TARGET_DEPTH ?
-                VK_IMAGE_ASPECT_DEPTH_BIT :
-                static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if ((oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL || oldState == ResourceState::RENDER_TARGET_DEPTH) &&
-                   (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL_READ || newState == ResourceState::RENDER_TARGET_DEPTH_READ)) {
-            srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-            srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-            aspectFlag = (newState == ResourceState::RENDER_TARGET_DEPTH_READ || oldState == ResourceState::RENDER_TARGET_DEPTH) ?
-                VK_IMAGE_ASPECT_DEPTH_BIT :
-                static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if ((oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL_READ || oldState == ResourceState::RENDER_TARGET_DEPTH_READ) &&
-                   (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL || newState == ResourceState::RENDER_TARGET_DEPTH)) {
-            srcStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            aspectFlag = (oldState == ResourceState::RENDER_TARGET_DEPTH_READ || newState == ResourceState::RENDER_TARGET_DEPTH)?
-                VK_IMAGE_ASPECT_DEPTH_BIT :
-                static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if (oldState == ResourceState::UNDEFINED &&
-            (newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL_READ || newState == ResourceState::RENDER_TARGET_DEPTH_READ)) {
-            srcStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-            aspectFlag = newState == ResourceState::RENDER_TARGET_DEPTH_READ ?
-                VK_IMAGE_ASPECT_DEPTH_BIT :
-                static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::RENDER_TARGET_DEPTH) {
-            srcStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-        } else if (oldState == ResourceState::RENDER_TARGET_COLOR && newState == ResourceState::PRESENT) {
-            srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-            srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            dstAccess = 0;
-            srcLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::PRESENT) {
-            srcStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-            dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-            srcAccess = 0;
-            dstAccess = 0;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::PRESENT) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = 0;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_GENERAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_GENERAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_GENERAL;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_GENERAL;
-            dstLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::RENDER_TARGET_COLOR) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::RENDER_TARGET_DEPTH) {
-            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            aspectFlag = VK_IMAGE_ASPECT_DEPTH_BIT;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::RENDER_TARGET_DEPTH_STENCIL) {
-            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            aspectFlag =  static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            aspectFlag = VK_IMAGE_ASPECT_DEPTH_BIT;
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            aspectFlag =  static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            aspectFlag = VK_IMAGE_ASPECT_DEPTH_BIT;
-        } else if (oldState == ResourceState::RENDER_TARGET_DEPTH_STENCIL && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            aspectFlag =  static_cast<VkImageAspectFlagBits>(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COPY_DST) {
-            srcStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::SHADER_READ) {
-            srcStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COMPUTE_READ) {
-            srcStage  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COPY_DST) {
-            srcStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_GENERAL;
-            dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_GENERAL;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COMPUTE_READ) {
-            srcStage  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-            srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        } else {
-            throw Exception("Not implemented");
+        const ResourceState oldState,
+        const ResourceState newState,
+        VkPipelineStageFlags& srcStage,
+        VkPipelineStageFlags& dstStage,
+        VkAccessFlags& srcAccess,
+        VkAccessFlags& dstAccess,
+        VkImageLayout& srcLayout,
+        VkImageLayout& dstLayout,
+        VkImageAspectFlagBits& aspectFlag) {
+        convertState(oldState, newState, srcStage, dstStage, srcAccess, dstAccess);
+        const auto& src = stateScopes[std::to_underlying(oldState)];
+        const auto& dst = stateScopes[std::to_underlying(newState)];
+        srcLayout = src.layout;
+        // An image can't be transitioned to the undefined layout : the content is discarded by keeping the layout
+        dstLayout = newState == ResourceState::UNDEFINED ? src.layout : dst.layout;
+        if (dst.aspect != 0) {
+            aspectFlag = static_cast<VkImageAspectFlagBits>(dst.aspect);
+        } else if (src.aspect != 0) {
+            aspectFlag = static_cast<VkImageAspectFlagBits>(src.aspect);
         }
     }
 
@@ -1191,174 +1087,14 @@ namespace vireo {
         VkPipelineStageFlags& dstStage,
         VkAccessFlags& srcAccess,
         VkAccessFlags& dstAccess) {
-        if (oldState == ResourceState::INDIRECT_DRAW && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-        } else if (oldState == ResourceState::INDIRECT_DRAW && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        }else if (oldState == ResourceState::INDIRECT_DRAW && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            dstStage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
-            srcAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        }else if (oldState == ResourceState::INDIRECT_DRAW && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COPY_DST){
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::INDIRECT_DRAW){
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COPY_SRC) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::INDIRECT_DRAW) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-        } else if (oldState == ResourceState::SHADER_READ && newState == ResourceState::INDIRECT_DRAW) {
-            srcStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-            dstStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::INDIRECT_DRAW) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::INDIRECT_DRAW) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-        } else if (oldState == ResourceState::COPY_SRC && newState == ResourceState::SHADER_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::VERTEX_INPUT) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-        } else if (oldState == ResourceState::VERTEX_INPUT && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        } else if (oldState == ResourceState::VERTEX_INPUT && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COMPUTE_WRITE) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_SHADER_WRITE_BIT;
-        } else if (oldState == ResourceState::COMPUTE_WRITE && newState == ResourceState::VERTEX_INPUT) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
-            dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::VERTEX_INPUT) {
-            srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::UNIFORM) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_UNIFORM_READ_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COMPUTE_READ) {
-            srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_SHADER_READ_BIT;
-        } else if (oldState == ResourceState::COMPUTE_READ && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_SHADER_READ_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        } else if (oldState == ResourceState::COPY_DST && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        } else if (oldState == ResourceState::UNDEFINED && newState == ResourceState::COPY_DST) {
-            srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            srcAccess = 0;
-            dstAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
-        } else {
-            throw Exception("Not implemented");
-        }
+        const auto& src = stateScopes[std::to_underlying(oldState)];
+        const auto& dst = stateScopes[std::to_underlying(newState)];
+        // Nothing to wait for an undefined content, but the transition must still happen after the
+        // semaphores waited at the destination stages (swap chain acquire)
+        srcStage = oldState == ResourceState::UNDEFINED ? dst.stage : src.stage;
+        dstStage = dst.stage;
+        srcAccess = src.srcAccess;
+        dstAccess = dst.dstAccess;
     }
 
     void VKCommandList::barrier(
@@ -1425,9 +1161,10 @@ namespace vireo {
         const ResourceState oldState,
         const ResourceState newState) const {
         assert(swapChain != nullptr);
+        const auto vkSwapChain = static_pointer_cast<const VKSwapChain>(swapChain);
         barrier(
-            static_pointer_cast<const VKSwapChain>(swapChain)->getCurrentImage(),
-            oldState, newState, false, false,
+            vkSwapChain->getCurrentImage(),
+            vkSwapChain->getImageState(oldState), vkSwapChain->getImageState(newState), false, false,
             0, 1, 0, Image::ALL_LAYERS);
     }
 
@@ -1457,6 +1194,105 @@ namespace vireo {
         barrier(std::vector<VkImage>{r.begin(), r.end()}, oldState, newState, firstArrayLayer, layerCount);
     }
 
+    VkPipelineStageFlags2 VKCommandList::toStage2(const VkPipelineStageFlags stage) {
+        if (stage == VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT || stage == VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT) {
+            return VK_PIPELINE_STAGE_2_NONE;
+        }
+        return stage;
+    }
+
+    void VKCommandList::barrier(const BarrierBatch& batch) const {
+        if (batch.empty()) { return; }
+        VkPipelineStageFlags srcStage, dstStage;
+        VkAccessFlags srcAccess, dstAccess;
+        VkImageLayout srcLayout, dstLayout;
+
+        auto memoryBarriers = std::vector<VkMemoryBarrier2>{};
+        memoryBarriers.reserve(batch.getMemoryBarriers().size());
+        for (const auto& memoryBarrier : batch.getMemoryBarriers()) {
+            convertState(memoryBarrier.oldState, memoryBarrier.newState, srcStage, dstStage, srcAccess, dstAccess);
+            memoryBarriers.push_back({
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                .srcStageMask = toStage2(srcStage),
+                .srcAccessMask = srcAccess,
+                .dstStageMask = toStage2(dstStage),
+                .dstAccessMask = dstAccess,
+            });
+        }
+
+        auto bufferBarriers = std::vector<VkBufferMemoryBarrier2>{};
+        bufferBarriers.reserve(batch.getBufferBarriers().size());
+        for (const auto& bufferBarrier : batch.getBufferBarriers()) {
+            convertState(bufferBarrier.oldState, bufferBarrier.newState, srcStage, dstStage, srcAccess, dstAccess);
+            bufferBarriers.push_back({
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+                .srcStageMask = toStage2(srcStage),
+                .srcAccessMask = srcAccess,
+                .dstStageMask = toStage2(dstStage),
+                .dstAccessMask = dstAccess,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .buffer = static_pointer_cast<const VKBuffer>(bufferBarrier.buffer)->getBuffer(),
+                .offset = 0,
+                .size = VK_WHOLE_SIZE,
+            });
+        }
+
+        auto imageBarriers = std::vector<VkImageMemoryBarrier2>{};
+        imageBarriers.reserve(batch.getImageBarriers().size());
+        for (const auto& imageBarrier : batch.getImageBarriers()) {
+            const auto& image = imageBarrier.image;
+            auto aspectFlag = static_cast<VkImageAspectFlagBits>(
+                image == nullptr ? VK_IMAGE_ASPECT_COLOR_BIT :
+                image->isDepthFormat() ? VK_IMAGE_ASPECT_DEPTH_BIT :
+                image->isDepthStencilFormat() ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT :
+                VK_IMAGE_ASPECT_COLOR_BIT);
+            const auto vkSwapChain = image == nullptr ?
+                static_pointer_cast<const VKSwapChain>(imageBarrier.swapChain) : nullptr;
+            convertState(
+                vkSwapChain ? vkSwapChain->getImageState(imageBarrier.oldState) : imageBarrier.oldState,
+                vkSwapChain ? vkSwapChain->getImageState(imageBarrier.newState) : imageBarrier.newState,
+                srcStage, dstStage,
+                srcAccess, dstAccess,
+                srcLayout, dstLayout,
+                aspectFlag);
+            imageBarriers.push_back({
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                .srcStageMask = toStage2(srcStage),
+                .srcAccessMask = srcAccess,
+                .dstStageMask = toStage2(dstStage),
+                .dstAccessMask = dstAccess,
+                .oldLayout = srcLayout,
+                .newLayout = dstLayout,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = vkSwapChain ?
+                    vkSwapChain->getCurrentImage() :
+                    static_pointer_cast<const VKImage>(image)->getImage(),
+                .subresourceRange = {
+                    .aspectMask = static_cast<uint32_t>(aspectFlag),
+                    .baseMipLevel = imageBarrier.firstMipLevel,
+                    .levelCount = imageBarrier.levelCount == Image::ALL_MIP_LEVELS ?
+                        VK_REMAINING_MIP_LEVELS : imageBarrier.levelCount,
+                    .baseArrayLayer = imageBarrier.firstArrayLayer,
+                    .layerCount = imageBarrier.layerCount == Image::ALL_LAYERS ?
+                        VK_REMAINING_ARRAY_LAYERS : imageBarrier.layerCount,
+                }
+            });
+        }
+
+        const auto dependencyInfo = VkDependencyInfo {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = static_cast<uint32_t>(memoryBarriers.size()),
+            .pMemoryBarriers = memoryBarriers.data(),
+            .bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()),
+            .pBufferMemoryBarriers = bufferBarriers.data(),
+            .imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()),
+            .pImageMemoryBarriers = imageBarriers.data(),
+        };
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+
     void VKCommandList::pushConstants(
         const std::shared_ptr<const PipelineResources>& pipelineResources,
         const PushConstantsDesc& pushConstants,
@@ -1484,56 +1320,123 @@ namespace vireo {
     }
 
     void VKCommandList::begin() const {
-        constexpr auto beginInfo = VkCommandBufferBeginInfo{
+        // Secondary command buffers recorded outside a render pass still need an inheritance info
+        constexpr auto inheritanceInfo = VkCommandBufferInheritanceInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        };
+        const auto beginInfo = VkCommandBufferBeginInfo{
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pInheritanceInfo = secondary ? &inheritanceInfo : nullptr,
         };
-        vkResetCommandBuffer(commandBuffer, 0);
         vkCheck(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+        descriptorBuffersBound = false;
+    }
+
+    void VKCommandList::begin(const CommandList& primary) const {
+        assert(secondary);
+        const auto& vkPrimary = static_cast<const VKCommandList&>(primary);
+        const auto renderingInfo = VkCommandBufferInheritanceRenderingInfo{
+            .sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+            .colorAttachmentCount    = static_cast<uint32_t>(vkPrimary.renderingColorFormats.size()),
+            .pColorAttachmentFormats = vkPrimary.renderingColorFormats.data(),
+            .depthAttachmentFormat   = vkPrimary.renderingDepthFormat,
+            .stencilAttachmentFormat = vkPrimary.renderingStencilFormat,
+            .rasterizationSamples    = vkPrimary.renderingSampleCount,
+        };
+        const auto inheritanceInfo = VkCommandBufferInheritanceInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+            .pNext = &renderingInfo,
+        };
+        const auto beginInfo = VkCommandBufferBeginInfo{
+            .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags            = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+            .pInheritanceInfo = &inheritanceInfo,
+        };
+        vkCheck(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+        descriptorBuffersBound = false;
     }
 
     void VKCommandList::end() const {
         vkCheck(vkEndCommandBuffer(commandBuffer));
     }
 
+    void VKCommandList::executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const {
+        assert(!secondary);
+        if (commandLists.empty()) { return; }
+        auto commandBuffers = std::vector<VkCommandBuffer>(commandLists.size());
+        for (int i = 0; i < commandLists.size(); i++) {
+            commandBuffers[i] = static_pointer_cast<const VKCommandList>(commandLists[i])->getCommandBuffer();
+        }
+        vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+        // The bindings of the primary command buffer are undefined after the execution of secondary ones
+        descriptorBuffersBound = false;
+    }
+
     void VKCommandList::cleanup() {
+        for (const auto ticket : stagingTickets) {
+            device->getStagingRing().release(ticket);
+        }
+        stagingTickets.clear();
         stagingBuffers.clear();
     }
 
-    void VKCommandList::upload(const Buffer& destination, const void* source) {
-        assert(source != nullptr);
-        const auto& buffer = static_cast<const VKBuffer&>(destination);
+    // Buffer offsets of buffer to image copies must be a multiple of the texel block size and of 4
+    static VkDeviceSize getStagingAlignment(const Image& image) {
+        return std::lcm(VkDeviceSize{16}, static_cast<VkDeviceSize>(Image::getPixelSize(image.getFormat())));
+    }
+
+    VKStagingAllocation VKCommandList::allocateStaging(
+        const VkDeviceSize size,
+        const VkDeviceSize alignment,
+        const std::string& name) {
+        auto allocation = VKStagingAllocation{};
+        if (device->getStagingRing().allocate(size, alignment, allocation)) {
+            stagingTickets.push_back(allocation.ticket);
+            return allocation;
+        }
+        // Oversized upload, or ring full because of command lists not yet cleaned up
         const auto stagingBuffer = std::make_shared<VKBuffer>(
             device,
             BufferType::BUFFER_UPLOAD,
-            buffer.getInstanceSize(),
-            buffer.getInstanceCount(),
-            "StagingBuffer for buffer");
+            size,
+            1,
+            name);
         stagingBuffer->map();
-        if ((buffer.getInstanceSizeAligned() == 1) || (buffer.getInstanceCount() == 1)) {
-            stagingBuffer->write(source);
+        stagingBuffers.push_back(stagingBuffer);
+        allocation.buffer = stagingBuffer->getBuffer();
+        allocation.offset = 0;
+        allocation.mappedAddress = stagingBuffer->getMappedAddress();
+        return allocation;
+    }
+
+    void VKCommandList::upload(const Buffer& destination, const void* source) {
+        const auto zone = CPUProfiler::Zone{"VKCommandList::upload"};
+        assert(source != nullptr);
+        const auto& buffer = static_cast<const VKBuffer&>(destination);
+        const auto staging = allocateStaging(buffer.getSize(), 16, "StagingBuffer for buffer");
+        auto* stagingAddress = static_cast<unsigned char*>(staging.mappedAddress);
+        if ((buffer.getInstanceSizeAligned() == buffer.getInstanceSize()) || (buffer.getInstanceCount() == 1)) {
+            memcpy(stagingAddress, source, buffer.getInstanceSize() * buffer.getInstanceCount());
         } else {
             for (int i = 0; i < buffer.getInstanceCount(); i++) {
-                stagingBuffer->write(
+                memcpy(
+                    stagingAddress + buffer.getInstanceSizeAligned() * i,
                     static_cast<const unsigned char*>(source) + i * buffer.getInstanceSize(),
-                    buffer.getInstanceSize(),
-                    buffer.getInstanceSizeAligned() * i);
+                    buffer.getInstanceSize());
             }
         }
-        stagingBuffer->unmap();
 
         const auto copyRegion = VkBufferCopy{
-            .srcOffset = 0,
+            .srcOffset = staging.offset,
             .dstOffset = 0,
             .size = buffer.getSize(),
         };
         vkCmdCopyBuffer(
             commandBuffer,
-            stagingBuffer->getBuffer(),
+            staging.buffer,
             buffer.getBuffer(),
             1,
             &copyRegion);
-
-        stagingBuffers.push_back(stagingBuffer);
     }
 
     void VKCommandList::copy(
@@ -1581,31 +1484,19 @@ namespace vireo {
         const Image& destination,
         const void* source,
         const uint32_t firstMipLevel) {
+        const auto zone = CPUProfiler::Zone{"VKCommandList::upload"};
         assert(source != nullptr);
         assert(firstMipLevel < destination.getMipLevels());
         const auto& image = static_cast<const VKImage&>(destination);
-        const auto stagingBuffer = std::make_shared<VKBuffer>(
-           device,
-           BufferType::IMAGE_UPLOAD,
-           image.getImageSize(),
-           image.getArraySize(),
-           "StagingBuffer for image");
-        stagingBuffer->map();
-        if (image.getArraySize() == 1) {
-            stagingBuffer->write(source);
-        } else {
-            for (int i = 0; i < image.getArraySize(); i++) {
-                stagingBuffer->write(
-                    static_cast<const unsigned char*>(source) + i * image.getImageSize(),
-                    image.getImageSize(),
-                    stagingBuffer->getInstanceSizeAligned() * i);
-            }
-        }
-        stagingBuffer->unmap();
+        const auto staging = allocateStaging(
+            static_cast<VkDeviceSize>(image.getImageSize()) * image.getArraySize(),
+            getStagingAlignment(image),
+            "StagingBuffer for image");
+        memcpy(staging.mappedAddress, source, static_cast<size_t>(image.getImageSize()) * image.getArraySize());
 
         // https://vulkan-tutorial.com/Texture_mapping/Images#page_Copying-buffer-to-image
         const auto region = VkBufferImageCopy {
-            .bufferOffset = 0,
+            .bufferOffset = staging.offset,
             .bufferRowLength = 0,
             .bufferImageHeight = 0,
             .imageSubresource = {
@@ -1620,13 +1511,11 @@ namespace vireo {
 
         vkCmdCopyBufferToImage(
                 commandBuffer,
-                stagingBuffer->getBuffer(),
+                staging.buffer,
                 image.getImage(),
                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                 1,
                 &region);
-
-        stagingBuffers.push_back(stagingBuffer);
     }
 
     void VKCommandList::copy(
@@ -1733,26 +1622,23 @@ namespace vireo {
         const Image& destination,
         const std::vector<void*>& sources,
         const uint32_t firstMipLevel) {
+        const auto zone = CPUProfiler::Zone{"VKCommandList::uploadArray"};
         assert(sources.size() == destination.getArraySize());
         assert(firstMipLevel < destination.getMipLevels());
         const auto& image = static_cast<const VKImage&>(destination);
-        const auto stagingBuffer = std::make_shared<VKBuffer>(
-           device,
-           BufferType::IMAGE_UPLOAD,
-           image.getImageSize(),
-           image.getArraySize(),
-           "StagingBuffer for image array");
-        stagingBuffer->map();
+        const auto staging = allocateStaging(
+            static_cast<VkDeviceSize>(image.getImageSize()) * image.getArraySize(),
+            getStagingAlignment(image),
+            "StagingBuffer for image array");
         for (int i = 0; i < image.getArraySize(); i++) {
-            stagingBuffer->write(
+            memcpy(
+                static_cast<unsigned char*>(staging.mappedAddress) + static_cast<size_t>(image.getImageSize()) * i,
                 sources[i],
-                image.getImageSize(),
-                stagingBuffer->getInstanceSizeAligned() * i);
+                image.getImageSize());
         }
-        stagingBuffer->unmap();
 
         const auto region = VkBufferImageCopy {
-            .bufferOffset = 0,
+            .bufferOffset = staging.offset,
             .bufferRowLength = 0,
             .bufferImageHeight = 0,
             .imageSubresource = {
@@ -1766,12 +1652,11 @@ namespace vireo {
         };
         vkCmdCopyBufferToImage(
                 commandBuffer,
-                stagingBuffer->getBuffer(),
+                staging.buffer,
                 image.getImage(),
                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                 1,
                 &region);
-        stagingBuffers.push_back(stagingBuffer);
     }
 
     void VKCommandList::copy(
@@ -1994,13 +1879,24 @@ namespace vireo {
         return results;
     }
 
-    void VKCommandList::writeTimestamp(const QueryPool& queryPool, const uint32_t queryIndex) {
+    void VKCommandList::resetQueryPool(
+        const QueryPool& queryPool,
+        const uint32_t firstQuery,
+        const uint32_t queryCount) {
+        assert(firstQuery + queryCount <= queryPool.getCapacity());
+        const auto& vkPool = static_cast<const VKQueryPool&>(queryPool);
+        vkCmdResetQueryPool(commandBuffer, vkPool.getQueryPool(), firstQuery, queryCount);
+    }
+
+    void VKCommandList::writeTimestamp(
+        const QueryPool& queryPool,
+        const uint32_t queryIndex,
+        const WaitStage stage) {
+        assert(stage != WaitStage::NONE);
         const auto& vkPool = static_cast<const VKQueryPool&>(queryPool);
-        // Reset the single slot before writing (required by Vulkan spec for host-reset)
-        vkCmdResetQueryPool(commandBuffer, vkPool.getQueryPool(), queryIndex, 1);
-        vkCmdWriteTimestamp(
+        vkCmdWriteTimestamp2(
             commandBuffer,
-            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VKSemaphore::vkWaitStageFlags[static_cast<int>(stage)],
             vkPool.getQueryPool(),
             queryIndex);
     }
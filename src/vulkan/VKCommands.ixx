@@ -13,6 +13,7 @@ import vireo;
 
 import vireo.vulkan.devices;
 import vireo.vulkan.descriptors;
+import vireo.vulkan.memory;
 import vireo.vulkan.resources;
 
 export namespace vireo {
@@ -138,11 +139,48 @@ export namespace vireo {
 
         void waitIdle() const override;
 
+        void setDeferred(bool deferred) override;
+
+        void flush() const override;
+
     private:
-        VkQueue commandQueue;
+        // Submission waiting for flush(), its semaphores and command buffers are stored in the pending arrays
+        struct Submission {
+            uint32_t waitCount;
+            uint32_t commandBufferCount;
+            uint32_t signalCount;
+            VkFence  fence;
+        };
+
+        // Size of the inline buffer for the pending submissions arrays, enough for a frame of submissions
+        static constexpr auto PENDING_BUFFER_SIZE{8192};
+        static constexpr auto PENDING_SUBMISSIONS{16};
+        static constexpr auto PENDING_COMMAND_BUFFERS{32};
+        static constexpr auto PENDING_SEMAPHORES{16};
 
+        VkQueue commandQueue;
+        bool    deferred{false};
+        // The heap is only used when the submissions of a flush() do not fit in the inline buffer
+        mutable std::array<std::byte, PENDING_BUFFER_SIZE>           pendingBuffer;
+        mutable std::pmr::monotonic_buffer_resource                  pendingResource{pendingBuffer.data(), pendingBuffer.size()};
+        mutable std::pmr::vector<Submission>                         pendingSubmissions{&pendingResource};
+        mutable std::pmr::vector<VkSemaphoreSubmitInfo>              pendingWaits{&pendingResource};
+        mutable std::pmr::vector<VkCommandBufferSubmitInfo>          pendingCommandBuffers{&pendingResource};
+        mutable std::pmr::vector<VkSemaphoreSubmitInfo>              pendingSignals{&pendingResource};
+        mutable std::pmr::vector<VkSubmitInfo2>                      submitInfos{&pendingResource};
+
+        // Adds a submission using the last `waitCount` pending waits, issued immediately if not in deferred mode.
+        // Must be called with the submit mutex locked.
+        void addSubmission(
+            uint32_t waitCount,
+            const std::vector<std::shared_ptr<const CommandList>>& commandLists,
+            const VkSemaphoreSubmitInfo* signal,
+            VkFence fence) const;
     };
 
+    class VKCommandList;
+
+    // Command lists are recycled : a command list released by the user is reused after the next reset()
     class VKCommandAllocator : public CommandAllocator {
     public:
         VKCommandAllocator(const std::shared_ptr<const VKDevice>& device, CommandType type);
@@ -155,9 +193,20 @@ export namespace vireo {
 
         std::shared_ptr<CommandList> createCommandList() const override;
 
+        std::shared_ptr<CommandList> createSecondaryCommandList() const override;
+
     private:
         const std::shared_ptr<const VKDevice> device;
         VkCommandPool                    commandPool;
+        mutable std::mutex               commandListsMutex;
+        // Command lists released by the user, indexed by level (primary, secondary), reusable after the next reset()
+        mutable std::array<std::vector<std::unique_ptr<VKCommandList>>, 2> releasedCommandLists;
+        // Command lists reset with the pool, indexed by level (primary, secondary)
+        mutable std::array<std::vector<std::unique_ptr<VKCommandList>>, 2> freeCommandLists;
+
+        std::shared_ptr<CommandList> getCommandList(bool secondary) const;
+
+        void recycle(VKCommandList* commandList) const;
     };
 
     class VKCommandList : public CommandList {
@@ -167,14 +216,18 @@ export namespace vireo {
             VK_INDEX_TYPE_UINT32,
         };
 
-        VKCommandList(const std::shared_ptr<const VKDevice>& device, VkCommandPool commandPool);
+        VKCommandList(const std::shared_ptr<const VKDevice>& device, VkCommandPool commandPool, bool secondary = false);
 
         ~VKCommandList() override;
 
         void begin() const override;
 
+        void begin(const CommandList& primary) const override;
+
         void end() const override;
 
+        void executeCommands(const std::vector<std::shared_ptr<const CommandList>>& commandLists) const override;
+
         void cleanup() override;
 
         void upload(
@@ -362,24 +415,51 @@ export namespace vireo {
             ResourceState oldState,
             ResourceState newState) const override;
 
+        void barrier(const BarrierBatch& batch) const override;
+
         void pushConstants(
             const std::shared_ptr<const PipelineResources>& pipelineResources,
             const PushConstantsDesc& pushConstants,
             const void* data) const override;
 
-        void writeTimestamp(const QueryPool& queryPool, uint32_t queryIndex) override;
+        void resetQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) override;
+
+        void writeTimestamp(const QueryPool& queryPool, uint32_t queryIndex, WaitStage stage) override;
 
         void resolveQueryPool(const QueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount) override;
 
         auto getCommandBuffer() const { return commandBuffer; }
 
+        auto isSecondary() const { return secondary; }
+
     private:
         const std::shared_ptr<const VKDevice>   device;
+        const bool                              secondary;
         VkCommandBuffer                         commandBuffer;
-        // Staging buffers used by the upload() methods
+        // Attachments formats of the current render pass, inherited by the secondary command lists
+        std::vector<VkFormat>                   renderingColorFormats{};
+        VkFormat                                renderingDepthFormat{VK_FORMAT_UNDEFINED};
+        VkFormat                                renderingStencilFormat{VK_FORMAT_UNDEFINED};
+        VkSampleCountFlagBits                   renderingSampleCount{VK_SAMPLE_COUNT_1_BIT};
+        // Dedicated staging buffers used by the upload() methods for oversized uploads
         std::vector<std::shared_ptr<VKBuffer>>  stagingBuffers{};
-
-        // Convert Vireo states to Vulkan state while trying to match pipeline stages
+        // Staging ring ranges used by the upload() methods, released by cleanup()
+        std::vector<uint64_t>                   stagingTickets{};
+        // Descriptor buffer mode : the device descriptor buffers are bound once per recording
+        mutable bool                            descriptorBuffersBound{false};
+
+        // Descriptor buffer mode : binds the descriptor sets by setting their offsets in the descriptor buffers
+        void setDescriptorBufferOffsets(
+            VkPipelineBindPoint bindPoint,
+            VkPipelineLayout pipelineLayout,
+            uint32_t firstSet,
+            const std::vector<const VKDescriptorSet*>& descriptorSets,
+            uint32_t dynamicOffset = 0) const;
+
+        // Get staging memory from the device ring, or from a dedicated buffer if the ring can't hold it
+        VKStagingAllocation allocateStaging(VkDeviceSize size, VkDeviceSize alignment, const std::string& name);
+
+        // Convert Vireo states to Vulkan stages, accesses and layouts by combining the scopes of the two states
         static void convertState(
             ResourceState oldState,
             ResourceState newState,
@@ -399,6 +479,9 @@ export namespace vireo {
             VkAccessFlags& srcAccess,
             VkAccessFlags& dstAccess);
 
+        // Sync1 stages have the same values with sync2, except for TOP_OF_PIPE/BOTTOM_OF_PIPE replaced by NONE
+        static VkPipelineStageFlags2 toStage2(VkPipelineStageFlags stage);
+
         void barrier(
             const std::vector<VkImage>& images,
             ResourceState oldState,
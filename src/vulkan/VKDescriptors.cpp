@@ -9,6 +9,7 @@ module;
 #include <cassert>
 module vireo.vulkan.descriptors;
 
+import vireo.profiler;
 import vireo.tools;
 
 import vireo.vulkan.resources;
@@ -16,8 +17,14 @@ import vireo.vulkan.tools;
 
 namespace vireo {
 
-    VKDescriptorLayout::VKDescriptorLayout(const VkDevice device, const bool samplers, const bool dynamic, const bool bindless, const std::string& name):
-        DescriptorLayout{samplers, dynamic, bindless}, device{device}, name{name} {
+    VKDescriptorLayout::VKDescriptorLayout(
+        const VkDevice device,
+        VKDescriptorHeap* descriptorHeap,
+        const bool samplers,
+        const bool dynamic,
+        const bool bindless,
+        const std::string& name):
+        DescriptorLayout{samplers, dynamic, bindless}, device{device}, descriptorHeap{descriptorHeap}, name{name} {
     }
 
     DescriptorLayout& VKDescriptorLayout::add(const DescriptorIndex index, const DescriptorType type, const size_t count) {
@@ -33,10 +40,13 @@ namespace vireo {
         if ((!isDynamicUniform()) && type == DescriptorType::UNIFORM_DYNAMIC) {
             throw Exception("Use uniform dynamic descriptor layout for UNIFORM_DYNAMIC resources");
         }
+        types[index] = type;
         poolSizes[index] = {
             .type =
                 type == DescriptorType::UNIFORM ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :
-                type == DescriptorType::UNIFORM_DYNAMIC ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC :
+                // Descriptor buffers do not support dynamic descriptors, see VKDescriptorSet
+                type == DescriptorType::UNIFORM_DYNAMIC ?
+                    descriptorHeap ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC :
                 type == DescriptorType::STORAGE ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
                 type == DescriptorType::DEVICE_STORAGE ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
                 type == DescriptorType::READWRITE_STORAGE ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
@@ -68,7 +78,10 @@ namespace vireo {
             VkDescriptorBindingFlags flags = 0;
             if (idx == lastIdx) {
                     // Only the last binding (the unbounded texture/image array) gets bindless flags.
-                    flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+                    // Descriptor buffers can be written while in use without update after bind.
+                    flags = descriptorHeap ?
+                        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT :
+                        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
                           | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
                           | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
                 }
@@ -89,7 +102,8 @@ namespace vireo {
         const auto layoutInfo = VkDescriptorSetLayoutCreateInfo {
             .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
             .pNext        = bindless ? &flagsInfo : nullptr,
-            .flags        = bindless ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT
+            .flags        = descriptorHeap ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT :
+                            bindless ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT
                                : static_cast<VkDescriptorSetLayoutCreateFlags>(0),
             .bindingCount = static_cast<uint32_t>(bindings.size()),
             .pBindings    = bindings.data(),
@@ -99,71 +113,481 @@ namespace vireo {
         vkSetObjectName(device, reinterpret_cast<uint64_t>(setLayout), VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT,
             "VKDescriptorLayout : " + name);
 #endif
+        if (descriptorHeap) {
+            // No pools nor templates : the sets are written directly in the descriptor buffers
+            const auto alignment = descriptorHeap->getProperties().descriptorBufferOffsetAlignment;
+            vkGetDescriptorSetLayoutSizeEXT(device, setLayout, &setSize);
+            setSize = std::max((setSize + alignment - 1) & ~(alignment - 1), alignment);
+            for (const auto idx : std::views::keys(poolSizes)) {
+                vkGetDescriptorSetLayoutBindingOffsetEXT(device, setLayout, idx, &bindingOffsets[idx]);
+            }
+            return;
+        }
+        allocator = std::make_unique<VKDescriptorAllocator>(*this);
+
+        // Bindless sets are too large to be written all at once
+        if (!bindless && !poolSizes.empty()) {
+            auto entries = std::vector<VkDescriptorUpdateTemplateEntry>{};
+            auto offset = uint32_t{0};
+            for (const auto& [idx, poolSize] : poolSizes) {
+                descriptorOffsets[idx] = offset;
+                entries.push_back({
+                    .dstBinding = idx,
+                    .dstArrayElement = 0,
+                    .descriptorCount = poolSize.descriptorCount,
+                    .descriptorType = poolSize.type,
+                    .offset = offset * sizeof(DescriptorData),
+                    .stride = sizeof(DescriptorData),
+                });
+                offset += poolSize.descriptorCount;
+            }
+            const auto templateInfo = VkDescriptorUpdateTemplateCreateInfo {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+                .descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size()),
+                .pDescriptorUpdateEntries = entries.data(),
+                .templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+                .descriptorSetLayout = setLayout,
+            };
+            vkCheck(vkCreateDescriptorUpdateTemplate(device, &templateInfo, nullptr, &updateTemplate));
+        }
     }
 
     VKDescriptorLayout::~VKDescriptorLayout() {
+        allocator.reset();
+        if (updateTemplate != VK_NULL_HANDLE) {
+            vkDestroyDescriptorUpdateTemplate(device, updateTemplate, nullptr);
+        }
         vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
     }
 
-    VKDescriptorSet::VKDescriptorSet(
-        const std::shared_ptr<const DescriptorLayout>& layout,
-        const std::string& name):
-        DescriptorSet {layout} {
-        const auto vkLayout = static_pointer_cast<const VKDescriptorLayout>(layout);
-        const auto setLayout = vkLayout->getSetLayout();
-        device = vkLayout->getDevice();
+    uint32_t VKDescriptorLayout::getVariableDescriptorCount() const {
+        return bindless && !poolSizes.empty() ? poolSizes.rbegin()->second.descriptorCount : 0;
+    }
+
+    VKDescriptorAllocator::VKDescriptorAllocator(const VKDescriptorLayout& layout) :
+        layout{layout} {
+        // Bindless sets are large, one set per pool
+        if (layout.isBindless()) {
+            nextPoolSize = 1;
+        }
+    }
 
-        const bool bindless = layout->isBindless();
+    VKDescriptorAllocator::~VKDescriptorAllocator() {
+        for (const auto pool : pools) {
+            vkDestroyDescriptorPool(layout.getDevice(), pool, nullptr);
+        }
+    }
 
-        std::vector<VkDescriptorPoolSize> poolSizes;
-        for (const auto &poolSize : vkLayout->getPoolSizes()) {
-            poolSizes.push_back(poolSize.second);
+    void VKDescriptorAllocator::createPool() {
+        auto poolSizes = std::vector<VkDescriptorPoolSize>{};
+        for (const auto& poolSize : std::views::values(layout.getPoolSizes())) {
+            poolSizes.push_back({
+                .type = poolSize.type,
+                .descriptorCount = poolSize.descriptorCount * nextPoolSize,
+            });
         }
         const auto poolInfo = VkDescriptorPoolCreateInfo {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
             // Bindless pools need UPDATE_AFTER_BIND_BIT to allow updates while descriptors are in use
-            .flags = bindless ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT
+            .flags = layout.isBindless() ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT
                         : static_cast<VkDescriptorPoolCreateFlags>(0),
-            .maxSets = static_cast<uint32_t>(vkLayout->getCapacity()),
+            .maxSets = nextPoolSize,
             .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
             .pPoolSizes = poolSizes.data(),
         };
-        vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool);
+        VkDescriptorPool pool;
+        vkCheck(vkCreateDescriptorPool(layout.getDevice(), &poolInfo, nullptr, &pool));
+        pools.push_back(pool);
+        remainingSets = nextPoolSize;
+        if (!layout.isBindless()) {
+            nextPoolSize = std::min(nextPoolSize * 2, MAX_POOL_SIZE);
+        }
+    }
 
-        const uint32_t variableCount = bindless && !vkLayout->getPoolSizes().empty()
-            ? vkLayout->getPoolSizes().rbegin()->second.descriptorCount
-            : 0;
-        const VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo {
+    VkDescriptorSet VKDescriptorAllocator::allocate() {
+        auto lock = std::lock_guard{mutex};
+        if (!freeSets.empty()) {
+            const auto set = freeSets.back();
+            freeSets.pop_back();
+            return set;
+        }
+        if (remainingSets == 0) {
+            createPool();
+        }
+        const auto setLayout = layout.getSetLayout();
+        const auto variableCount = layout.getVariableDescriptorCount();
+        const auto variableCountInfo = VkDescriptorSetVariableDescriptorCountAllocateInfo {
             .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
             .pNext              = nullptr,
             .descriptorSetCount = 1,
             .pDescriptorCounts  = &variableCount,
         };
-
         const auto allocInfo = VkDescriptorSetAllocateInfo {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-            .pNext = bindless ? &variableCountInfo : nullptr,
-            .descriptorPool = pool,
+            .pNext = layout.isBindless() ? &variableCountInfo : nullptr,
+            .descriptorPool = pools.back(),
             .descriptorSetCount = 1,
             .pSetLayouts = &setLayout,
         };
-        vkAllocateDescriptorSets(device, &allocInfo, &set);
+        VkDescriptorSet set;
+        vkCheck(vkAllocateDescriptorSets(layout.getDevice(), &allocInfo, &set));
+        remainingSets -= 1;
+        return set;
+    }
+
+    void VKDescriptorAllocator::release(const VkDescriptorSet set) {
+        // The set keeps its descriptors until reused, like a set freed with vkFreeDescriptorSets it
+        // must not be used by commands in flight
+        auto lock = std::lock_guard{mutex};
+        freeSets.push_back(set);
+    }
+
+    VKTransientDescriptorAllocator::VKTransientDescriptorAllocator(
+        const VkDevice device,
+        VKDescriptorHeap* descriptorHeap,
+        const std::string& name) :
+        device{device},
+        descriptorHeap{descriptorHeap},
+        name{name} {
+        if (!descriptorHeap) {
+            createPool();
+        }
+    }
+
+    VKTransientDescriptorAllocator::~VKTransientDescriptorAllocator() {
+        for (const auto pool : pools) {
+            vkDestroyDescriptorPool(device, pool, nullptr);
+        }
+    }
 
+    void VKTransientDescriptorAllocator::createPool() {
+        static constexpr auto types = std::array {
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            VK_DESCRIPTOR_TYPE_SAMPLER,
+        };
+        auto poolSizes = std::array<VkDescriptorPoolSize, types.size()>{};
+        for (int i = 0; i < types.size(); i++) {
+            poolSizes[i] = { .type = types[i], .descriptorCount = POOL_DESCRIPTORS };
+        }
+        const auto poolInfo = VkDescriptorPoolCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .maxSets = POOL_SETS,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data(),
+        };
+        VkDescriptorPool pool;
+        vkCheck(vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool));
 #ifdef _DEBUG
         vkSetObjectName(device, reinterpret_cast<uint64_t>(pool), VK_OBJECT_TYPE_DESCRIPTOR_POOL,
-             "VKDescriptorSet Pool : " + name);
+             "VKTransientDescriptorAllocator Pool : " + name);
+#endif
+        pools.push_back(pool);
+    }
+
+    std::shared_ptr<DescriptorSet> VKTransientDescriptorAllocator::createDescriptorSet(
+        const std::shared_ptr<const DescriptorLayout>& layout,
+        const std::string& name) {
+        assert(!layout->isBindless());
+        if (descriptorHeap) {
+            const auto set = std::make_shared<VKDescriptorSet>(layout, name);
+            sets.push_back(set);
+            return set;
+        }
+        const auto setLayout = static_pointer_cast<const VKDescriptorLayout>(layout)->getSetLayout();
+        // The current pool has been created for this allocation
+        auto newPool = false;
+        while (true) {
+            const auto allocInfo = VkDescriptorSetAllocateInfo {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                .descriptorPool = pools[currentPool],
+                .descriptorSetCount = 1,
+                .pSetLayouts = &setLayout,
+            };
+            VkDescriptorSet set;
+            const auto result = vkAllocateDescriptorSets(device, &allocInfo, &set);
+            if (result == VK_SUCCESS) {
+                return std::make_shared<VKDescriptorSet>(layout, set, name);
+            }
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) {
+                vkCheck(result);
+            }
+            if (newPool) {
+                throw Exception(
+                    "VKTransientDescriptorAllocator : the descriptor layout does not fit in a pool of ",
+                    POOL_DESCRIPTORS, " descriptors per type");
+            }
+            // The current pool is full, continue with the next one
+            currentPool += 1;
+            if (currentPool == pools.size()) {
+                createPool();
+                newPool = true;
+            }
+        }
+    }
+
+    void VKTransientDescriptorAllocator::reset() {
+        sets.clear();
+        for (const auto pool : pools) {
+            vkResetDescriptorPool(device, pool, 0);
+        }
+        currentPool = 0;
+    }
+
+    VKDescriptorSet::VKDescriptorSet(
+        const std::shared_ptr<const DescriptorLayout>& layout,
+        const std::string& name):
+        DescriptorSet {layout} {
+        const auto vkLayout = static_pointer_cast<const VKDescriptorLayout>(layout);
+        device = vkLayout->getDevice();
+        descriptorHeap = vkLayout->getDescriptorHeap();
+        if (descriptorHeap) {
+            // The range of dynamic uniform sets depends on the buffer, it is allocated by update()
+            if (!layout->isDynamicUniform()) {
+                range = descriptorHeap->allocate(vkLayout->getSetSize(), layout->isSamplers());
+            }
+            return;
+        }
+        set = vkLayout->getAllocator().allocate();
+#ifdef _DEBUG
+        vkSetObjectName(device, reinterpret_cast<uint64_t>(set), VK_OBJECT_TYPE_DESCRIPTOR_SET,
+            "VKDescriptorSet : " + name);
+#endif
+    }
+
+    VKDescriptorSet::VKDescriptorSet(
+        const std::shared_ptr<const DescriptorLayout>& layout,
+        const VkDescriptorSet set,
+        const std::string& name):
+        DescriptorSet {layout},
+        device{static_pointer_cast<const VKDescriptorLayout>(layout)->getDevice()},
+        set{set},
+        transient{true} {
+#ifdef _DEBUG
         vkSetObjectName(device, reinterpret_cast<uint64_t>(set), VK_OBJECT_TYPE_DESCRIPTOR_SET,
             "VKDescriptorSet : " + name);
 #endif
     }
 
     VKDescriptorSet::~VKDescriptorSet() {
-        vkDestroyDescriptorPool(device, pool, nullptr);
-        // vkFreeDescriptorSets(static_cast<const VKDescriptorLayout&>(layout).getDevice(), set, nullptr);
+        if (descriptorHeap) {
+            if (range.mappedAddress) {
+                descriptorHeap->free(range);
+            }
+        } else if (!transient) {
+            static_pointer_cast<const VKDescriptorLayout>(layout)->getAllocator().release(set);
+        }
+    }
+
+    VKDescriptorLayout::DescriptorData VKDescriptorSet::getDescriptorData(const Buffer& buffer, const VkDescriptorType type) {
+        const auto& vkBuffer = static_cast<const VKBuffer&>(buffer);
+        return { .buffer = {
+            .buffer = vkBuffer.getBuffer(),
+            .offset = 0,
+            .range = type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ? vkBuffer.getInstanceSizeAligned() : VK_WHOLE_SIZE,
+        }};
+    }
+
+    VKDescriptorLayout::DescriptorData VKDescriptorSet::getDescriptorData(const Image& image, const VkDescriptorType type) {
+        return { .image = {
+            .sampler = VK_NULL_HANDLE,
+            .imageView = static_cast<const VKImage&>(image).getImageView(),
+            .imageLayout = type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        }};
+    }
+
+    VKDescriptorLayout::DescriptorData VKDescriptorSet::getDescriptorData(const Sampler& sampler, VkDescriptorType) {
+        return { .image = {
+            .sampler = static_cast<const VKSampler&>(sampler).getSampler(),
+            .imageView = VK_NULL_HANDLE,
+            .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        }};
+    }
+
+    VkDeviceSize VKDescriptorSet::getBufferOffset(const uint32_t dynamicOffset) const {
+        assert(descriptorHeap != nullptr);
+        if (dynamicInstanceSize == 0) {
+            return range.offset;
+        }
+        const auto setSize = static_pointer_cast<const VKDescriptorLayout>(layout)->getSetSize();
+        return range.offset + dynamicOffset / dynamicInstanceSize * setSize;
+    }
+
+    void VKDescriptorSet::copyDescriptor(
+        const DescriptorIndex index,
+        const uint32_t arrayElement,
+        const VkDescriptorGetInfoEXT& info,
+        const VkDeviceSize setOffset) const {
+        assert(range.mappedAddress != nullptr);
+        const auto size = descriptorHeap->getDescriptorSize(info.type);
+        const auto offset = setOffset +
+            static_pointer_cast<const VKDescriptorLayout>(layout)->getBindingOffset(index) +
+            arrayElement * size;
+        vkGetDescriptorEXT(device, &info, size, static_cast<char*>(range.mappedAddress) + offset);
+    }
+
+    void VKDescriptorSet::writeBufferDescriptor(
+        const DescriptorIndex index,
+        const uint32_t arrayElement,
+        const VkDescriptorType type,
+        const Buffer& buffer,
+        const VkDeviceSize offset,
+        const VkDeviceSize size,
+        const VkDeviceSize setOffset) const {
+        const auto addressInfo = VkDescriptorAddressInfoEXT {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+            .address = static_cast<const VKBuffer&>(buffer).getDeviceAddress() + offset,
+            .range = size,
+            .format = VK_FORMAT_UNDEFINED,
+        };
+        auto info = VkDescriptorGetInfoEXT {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+            .type = type,
+        };
+        if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+            info.data.pUniformBuffer = &addressInfo;
+        } else {
+            info.data.pStorageBuffer = &addressInfo;
+        }
+        copyDescriptor(index, arrayElement, info, setOffset);
+    }
+
+    void VKDescriptorSet::writeImageDescriptor(
+        const DescriptorIndex index,
+        const uint32_t arrayElement,
+        const VkDescriptorType type,
+        const VkDescriptorImageInfo& imageInfo) const {
+        auto info = VkDescriptorGetInfoEXT {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+            .type = type,
+        };
+        if (type == VK_DESCRIPTOR_TYPE_SAMPLER) {
+            info.data.pSampler = &imageInfo.sampler;
+        } else if (type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE) {
+            info.data.pStorageImage = &imageInfo;
+        } else {
+            info.data.pSampledImage = &imageInfo;
+        }
+        copyDescriptor(index, arrayElement, info);
+    }
+
+    void VKDescriptorSet::writeDescriptor(
+        const DescriptorIndex index,
+        const uint32_t arrayElement,
+        const VkDescriptorType type,
+        const Buffer& buffer) {
+        if (layout->isDynamicUniform()) {
+            update(index, buffer, false);
+        } else {
+            writeBufferDescriptor(index, arrayElement, type, buffer, 0, buffer.getSize());
+        }
+    }
+
+    void VKDescriptorSet::writeDescriptor(
+        const DescriptorIndex index,
+        const uint32_t arrayElement,
+        const VkDescriptorType type,
+        const Image& image) const {
+        writeImageDescriptor(index, arrayElement, type, getDescriptorData(image, type).image);
+    }
+
+    void VKDescriptorSet::writeDescriptor(
+        const DescriptorIndex index,
+        const uint32_t arrayElement,
+        const VkDescriptorType type,
+        const Sampler& sampler) const {
+        writeImageDescriptor(index, arrayElement, type, getDescriptorData(sampler, type).image);
+    }
+
+    void VKDescriptorSet::update(const std::vector<DescriptorWrite>& writes) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
+        if (writes.empty()) { return; }
+        const auto vkLayout = static_pointer_cast<const VKDescriptorLayout>(layout);
+        if (descriptorHeap) {
+            for (const auto& write : writes) {
+                const auto type = vkLayout->getPoolSizes().at(write.index).type;
+                std::visit([&](const auto& resource) {
+                    assert(resource != nullptr);
+                    writeDescriptor(write.index, write.arrayElement, type, *resource);
+                }, write.resource);
+            }
+            return;
+        }
+        auto data = std::vector<VKDescriptorLayout::DescriptorData>(writes.size());
+        auto types = std::vector<VkDescriptorType>(writes.size());
+        for (int i = 0; i < writes.size(); i++) {
+            types[i] = vkLayout->getPoolSizes().at(writes[i].index).type;
+            data[i] = std::visit([&](const auto& resource) {
+                assert(resource != nullptr);
+                return getDescriptorData(*resource, types[i]);
+            }, writes[i].resource);
+        }
+        if (vkLayout->getUpdateTemplate() != VK_NULL_HANDLE && writes.size() >= layout->getCapacity()) {
+            // The template is only used when the batch itself writes all the descriptors of the set : the
+            // resources of previous updates are not owned by the set and may have been destroyed since
+            auto descriptors = std::vector<VKDescriptorLayout::DescriptorData>(layout->getCapacity());
+            auto written = std::vector<bool>(layout->getCapacity(), false);
+            auto writtenCount = size_t{0};
+            for (int i = 0; i < writes.size(); i++) {
+                const auto position = vkLayout->getDescriptorOffsets().at(writes[i].index) + writes[i].arrayElement;
+                assert(position < descriptors.size());
+                descriptors[position] = data[i];
+                if (!written[position]) {
+                    written[position] = true;
+                    writtenCount += 1;
+                }
+            }
+            if (writtenCount == descriptors.size()) {
+                vkUpdateDescriptorSetWithTemplate(device, set, vkLayout->getUpdateTemplate(), descriptors.data());
+                return;
+            }
+        }
+        auto descriptorWrites = std::vector<VkWriteDescriptorSet>(writes.size());
+        for (int i = 0; i < writes.size(); i++) {
+            const auto isBuffer = std::holds_alternative<std::shared_ptr<const Buffer>>(writes[i].resource);
+            descriptorWrites[i] = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet = set,
+                .dstBinding = writes[i].index,
+                .dstArrayElement = writes[i].arrayElement,
+                .descriptorCount = 1,
+                .descriptorType = types[i],
+                .pImageInfo = isBuffer ? nullptr : &data[i].image,
+                .pBufferInfo = isBuffer ? &data[i].buffer : nullptr,
+            };
+        }
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
     }
 
     void VKDescriptorSet::update(const DescriptorIndex index, const Buffer& buffer, const bool useWholeSize) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
         assert(!layout->isSamplers());
+        if (descriptorHeap) {
+            const auto type = buffer.getType() == BufferType::UNIFORM ?
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            if (layout->isDynamicUniform()) {
+                const auto setSize = static_pointer_cast<const VKDescriptorLayout>(layout)->getSetSize();
+                if (dynamicInstanceCount != buffer.getInstanceCount()) {
+                    if (range.mappedAddress) {
+                        descriptorHeap->free(range);
+                    }
+                    range = descriptorHeap->allocate(setSize * buffer.getInstanceCount(), false);
+                    dynamicInstanceCount = buffer.getInstanceCount();
+                }
+                dynamicInstanceSize = buffer.getInstanceSizeAligned();
+                for (uint32_t i = 0; i < dynamicInstanceCount; i++) {
+                    writeBufferDescriptor(index, 0, type, buffer, i * dynamicInstanceSize, dynamicInstanceSize, i * setSize);
+                }
+            } else {
+                writeBufferDescriptor(index, 0, type, buffer, 0,
+                    useWholeSize ? buffer.getSize() : buffer.getInstanceSizeAligned());
+            }
+            return;
+        }
         const auto& vkBuffer = static_cast<const VKBuffer&>(buffer);
         const auto bufferInfo = VkDescriptorBufferInfo {
             .buffer = vkBuffer.getBuffer(),
@@ -187,6 +611,7 @@ namespace vireo {
     }
 
     void VKDescriptorSet::update(const DescriptorIndex index, const Image& image, const bool forceShaderRead) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
         assert(!layout->isDynamicUniform());
         assert(!layout->isSamplers());
         const auto& vkImage = static_cast<const VKImage&>(image);
@@ -195,6 +620,14 @@ namespace vireo {
             .imageView = vkImage.getImageView(),
             .imageLayout = image.isReadWrite() && !forceShaderRead ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
         };
+        if (descriptorHeap) {
+            writeImageDescriptor(
+                index,
+                0,
+                image.isReadWrite() && !forceShaderRead ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                imageInfo);
+            return;
+        }
         const auto write = VkWriteDescriptorSet {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .dstSet = set,
@@ -208,6 +641,7 @@ namespace vireo {
     }
 
     void VKDescriptorSet::update(const DescriptorIndex index, const Sampler& sampler) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
         assert(layout->isSamplers());
         const auto& vkSampler = static_cast<const VKSampler&>(sampler);
         const auto imageInfo = VkDescriptorImageInfo {
@@ -215,6 +649,10 @@ namespace vireo {
             .imageView = VK_NULL_HANDLE,
             .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
         };
+        if (descriptorHeap) {
+            writeImageDescriptor(index, 0, VK_DESCRIPTOR_TYPE_SAMPLER, imageInfo);
+            return;
+        }
         const auto write = VkWriteDescriptorSet {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .dstSet = set,
@@ -228,6 +666,7 @@ namespace vireo {
     }
 
     void VKDescriptorSet::update(const DescriptorIndex index, const std::vector<std::shared_ptr<Buffer>>& buffers) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
         assert(!layout->isDynamicUniform());
         assert(!layout->isSamplers());
         assert(buffers.size() > 0);
@@ -239,6 +678,12 @@ namespace vireo {
             buffersInfo[i].buffer = vkBuffer->getBuffer();
             buffersInfo[i].range = vkBuffer->getSize();
         }
+        if (descriptorHeap) {
+            for (int i = 0; i < buffers.size(); i++) {
+                writeBufferDescriptor(index, i, type, *buffers[i], 0, buffers[i]->getSize());
+            }
+            return;
+        }
         const auto write = VkWriteDescriptorSet {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .dstSet = set,
@@ -252,6 +697,7 @@ namespace vireo {
     }
 
     void VKDescriptorSet::update(const DescriptorIndex index, const std::vector<std::shared_ptr<Image>>& images) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
         assert(!layout->isDynamicUniform());
         assert(!layout->isSamplers());
         assert(images.size() > 0);
@@ -265,6 +711,12 @@ namespace vireo {
             // imagesInfo[i].imageLayout = images[i]->isReadWrite() ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             // isStorage |= images[i]->isReadWrite();
         }
+        if (descriptorHeap) {
+            for (int i = 0; i < imagesInfo.size(); i++) {
+                writeImageDescriptor(index, i, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, imagesInfo[i]);
+            }
+            return;
+        }
         const auto write = VkWriteDescriptorSet {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .dstSet = set,
@@ -279,6 +731,7 @@ namespace vireo {
     }
 
     void VKDescriptorSet::update(const DescriptorIndex index, const std::vector<std::shared_ptr<Sampler>>&samplers) {
+        const auto zone = CPUProfiler::Zone{"VKDescriptorSet::update"};
         assert(layout->isSamplers());
         assert(samplers.size() > 0);
         auto imagesInfo = std::vector<VkDescriptorImageInfo>(samplers.size());
@@ -287,6 +740,12 @@ namespace vireo {
             imagesInfo[i].imageView = VK_NULL_HANDLE;
             imagesInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
         }
+        if (descriptorHeap) {
+            for (int i = 0; i < imagesInfo.size(); i++) {
+                writeImageDescriptor(index, i, VK_DESCRIPTOR_TYPE_SAMPLER, imagesInfo[i]);
+            }
+            return;
+        }
         const auto write = VkWriteDescriptorSet {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .dstSet = set,
@@ -10,12 +10,59 @@ export module vireo.vulkan.descriptors;
 
 import std;
 import vireo;
+import vireo.vulkan.memory;
 
 export namespace vireo {
 
+    class VKDescriptorLayout;
+
+    // Allocates the descriptor sets of a layout from pools of growing size.
+    // Released sets are kept and reused by the next allocations.
+    class VKDescriptorAllocator {
+    public:
+        // Number of sets of the first pool, the next pools double in size
+        static constexpr uint32_t FIRST_POOL_SIZE{16};
+        static constexpr uint32_t MAX_POOL_SIZE{512};
+
+        VKDescriptorAllocator(const VKDescriptorLayout& layout);
+
+        ~VKDescriptorAllocator();
+
+        VkDescriptorSet allocate();
+
+        void release(VkDescriptorSet set);
+
+        VKDescriptorAllocator(VKDescriptorAllocator&) = delete;
+        VKDescriptorAllocator& operator = (const VKDescriptorAllocator&) = delete;
+
+    private:
+        const VKDescriptorLayout&     layout;
+        std::mutex                    mutex;
+        std::vector<VkDescriptorPool> pools;
+        std::vector<VkDescriptorSet>  freeSets;
+        // Sets still available in the last pool
+        uint32_t                      remainingSets{0};
+        uint32_t                      nextPoolSize{FIRST_POOL_SIZE};
+
+        void createPool();
+    };
+
     class VKDescriptorLayout : public DescriptorLayout {
     public:
-        VKDescriptorLayout(VkDevice device, bool samplers, bool dynamic, bool bindless, const std::string& name);
+        // Element of the data given to the update template
+        union DescriptorData {
+            VkDescriptorImageInfo  image;
+            VkDescriptorBufferInfo buffer;
+        };
+
+        // With a descriptor heap the sets are ranges of the device descriptor buffers instead of pool allocations
+        VKDescriptorLayout(
+            VkDevice device,
+            VKDescriptorHeap* descriptorHeap,
+            bool samplers,
+            bool dynamic,
+            bool bindless,
+            const std::string& name);
 
         ~VKDescriptorLayout() override;
 
@@ -29,17 +76,75 @@ export namespace vireo {
 
         const auto& getPoolSizes() const { return poolSizes; }
 
+        // Number of descriptors of the variable size binding of bindless layouts
+        uint32_t getVariableDescriptorCount() const;
+
+        auto& getAllocator() const { return *allocator; }
+
+        // Template writing all the descriptors of a set, VK_NULL_HANDLE for bindless layouts
+        auto getUpdateTemplate() const { return updateTemplate; }
+
+        // Position of the first descriptor of each binding in the update template data
+        const auto& getDescriptorOffsets() const { return descriptorOffsets; }
+
+        // Descriptor buffers used by the sets, nullptr when the sets are allocated from pools
+        auto getDescriptorHeap() const { return descriptorHeap; }
+
+        // Size of a set in the descriptor buffers
+        auto getSetSize() const { return setSize; }
+
+        // Position of a binding in the range of a set
+        auto getBindingOffset(const DescriptorIndex index) const { return bindingOffsets.at(index); }
+
     private:
         VkDevice device;
+        VKDescriptorHeap* descriptorHeap;
         VkDescriptorSetLayout setLayout{nullptr};
         const std::string name;
         std::map<DescriptorIndex, VkDescriptorPoolSize> poolSizes;
+        std::unique_ptr<VKDescriptorAllocator> allocator;
+        VkDescriptorUpdateTemplate updateTemplate{VK_NULL_HANDLE};
+        std::map<DescriptorIndex, uint32_t> descriptorOffsets;
+        VkDeviceSize setSize{0};
+        std::map<DescriptorIndex, VkDeviceSize> bindingOffsets;
+    };
+
+    class VKTransientDescriptorAllocator : public TransientDescriptorAllocator {
+    public:
+        // Number of sets and descriptors of each type in a pool
+        static constexpr uint32_t POOL_SETS{256};
+        static constexpr uint32_t POOL_DESCRIPTORS{1024};
+
+        VKTransientDescriptorAllocator(VkDevice device, VKDescriptorHeap* descriptorHeap, const std::string& name);
+
+        ~VKTransientDescriptorAllocator() override;
+
+        std::shared_ptr<DescriptorSet> createDescriptorSet(
+            const std::shared_ptr<const DescriptorLayout>& layout,
+            const std::string& name) override;
+
+        void reset() override;
+
+    private:
+        VkDevice                      device;
+        VKDescriptorHeap*             descriptorHeap;
+        const std::string             name;
+        std::vector<VkDescriptorPool> pools;
+        // Pool used for the next allocations
+        uint32_t                      currentPool{0};
+        // With descriptor buffers the sets are ranges of the heap, kept alive until reset()
+        std::vector<std::shared_ptr<DescriptorSet>> sets;
+
+        void createPool();
     };
 
     class VKDescriptorSet : public DescriptorSet {
     public:
         VKDescriptorSet(const std::shared_ptr<const DescriptorLayout>& layout, const std::string& name);
 
+        // Descriptor set allocated by a VKTransientDescriptorAllocator
+        VKDescriptorSet(const std::shared_ptr<const DescriptorLayout>& layout, VkDescriptorSet set, const std::string& name);
+
         ~VKDescriptorSet() override;
 
         void update(const DescriptorIndex index, const std::shared_ptr<const Buffer>& buffer, const bool useWholeSize) override {
@@ -72,14 +177,63 @@ export namespace vireo {
 
         void update(DescriptorIndex index, const std::vector<std::shared_ptr<Sampler>>& samplers) override;
 
+        void update(const std::vector<DescriptorWrite>& writes) override;
+
         auto getSet() const { return set; }
 
-        auto getPool() const { return pool; }
+        // Descriptor buffer holding the set, VKDescriptorHeap::RESOURCES_BUFFER or VKDescriptorHeap::SAMPLERS_BUFFER
+        uint32_t getBufferIndex() const {
+            return range.samplers ? VKDescriptorHeap::SAMPLERS_BUFFER : VKDescriptorHeap::RESOURCES_BUFFER;
+        }
+
+        // Offset of the set in its descriptor buffer
+        VkDeviceSize getBufferOffset(uint32_t dynamicOffset = 0) const;
 
     private:
         VkDevice         device;
-        VkDescriptorSet  set;
-        VkDescriptorPool pool;
+        VkDescriptorSet  set{VK_NULL_HANDLE};
+        // Descriptor buffer mode : the set is a range of the device descriptor heap
+        VKDescriptorHeap* descriptorHeap{nullptr};
+        VKDescriptorRange range{};
+        // Descriptor buffers have no dynamic descriptors : dynamic uniform sets have one copy
+        // of the set per buffer instance, selected by the dynamic offset
+        VkDeviceSize     dynamicInstanceSize{0};
+        size_t           dynamicInstanceCount{0};
+        // Transient sets are released all together by their allocator
+        bool             transient{false};
+
+        static VKDescriptorLayout::DescriptorData getDescriptorData(const Buffer& buffer, VkDescriptorType type);
+
+        static VKDescriptorLayout::DescriptorData getDescriptorData(const Image& image, VkDescriptorType type);
+
+        static VKDescriptorLayout::DescriptorData getDescriptorData(const Sampler& sampler, VkDescriptorType type);
+
+        void copyDescriptor(
+            DescriptorIndex index,
+            uint32_t arrayElement,
+            const VkDescriptorGetInfoEXT& info,
+            VkDeviceSize setOffset = 0) const;
+
+        void writeBufferDescriptor(
+            DescriptorIndex index,
+            uint32_t arrayElement,
+            VkDescriptorType type,
+            const Buffer& buffer,
+            VkDeviceSize offset,
+            VkDeviceSize size,
+            VkDeviceSize setOffset = 0) const;
+
+        void writeImageDescriptor(
+            DescriptorIndex index,
+            uint32_t arrayElement,
+            VkDescriptorType type,
+            const VkDescriptorImageInfo& imageInfo) const;
+
+        void writeDescriptor(DescriptorIndex index, uint32_t arrayElement, VkDescriptorType type, const Buffer& buffer);
+
+        void writeDescriptor(DescriptorIndex index, uint32_t arrayElement, VkDescriptorType type, const Image& image) const;
+
+        void writeDescriptor(DescriptorIndex index, uint32_t arrayElement, VkDescriptorType type, const Sampler& sampler) const;
     };
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 * https://opensource.org/licenses/MIT
 */
 module;
+#include <cassert>
 #include "vireo/backend/vulkan/Libraries.h"
 #ifdef _WIN32
     #include <Windows.h>
@@ -112,19 +113,22 @@ namespace vireo {
 
         std::vector<const char *> instanceExtensions{};
         instanceExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        // Without window system the surface extensions may not be available
+        if (!config.headless) {
 #ifdef _WIN32
-        instanceExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
-        instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+            instanceExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+            instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
 #elifdef USE_SDL3
-        uint32_t sdlInstanceExtensionsCount;
-        auto* sdlInstanceExtensions = SDL_Vulkan_GetInstanceExtensions(&sdlInstanceExtensionsCount);
-        if (sdlInstanceExtensions == nullptr) {
-            throw Exception("VKInstance : can't get SDL3 Vulkan extensions - ", SDL_GetError());
-        }
-        for (auto i = 0; i < sdlInstanceExtensionsCount; i++) {
-            instanceExtensions.push_back(sdlInstanceExtensions[i]);
-        }
+            uint32_t sdlInstanceExtensionsCount;
+            auto* sdlInstanceExtensions = SDL_Vulkan_GetInstanceExtensions(&sdlInstanceExtensionsCount);
+            if (sdlInstanceExtensions == nullptr) {
+                throw Exception("VKInstance : can't get SDL3 Vulkan extensions - ", SDL_GetError());
+            }
+            for (auto i = 0; i < sdlInstanceExtensionsCount; i++) {
+                instanceExtensions.push_back(sdlInstanceExtensions[i]);
+            }
 #endif
+        }
 #ifdef _DEBUG
         instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
         instanceExtensions.push_back(VK_EXT_VALIDATION_FEATURES_EXTENSION_NAME);
@@ -207,12 +211,10 @@ instanceExtensions.data()};
         vulkanFinalize();
     }
 
-    VKPhysicalDevice::VKPhysicalDevice(const VkInstance instance):
+    VKPhysicalDevice::VKPhysicalDevice(const VkInstance instance, const bool descriptorBuffer, const bool headless):
         instance(instance),
         // Requested device extensions
         deviceExtensions {
-            // Mandatory to create a swap chain
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME,
             // https://docs.vulkan.org/samples/latest/samples/extensions/dynamic_rendering/README.html
             VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
             // for Vulkan Memory Allocator
@@ -227,6 +229,10 @@ instanceExtensions.data()};
             VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME,
 #endif
         }{
+        if (!headless) {
+            // Mandatory to create a swap chain
+            deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
         //////////////////// Find the best GPU
         // Check for at least one supported Vulkan physical device
         // https://vulkan-tutorial.com/Drawing_a_triangle/Setup/Physical_devices_and_queue_families#page_Selecting-a-physical-device
@@ -255,6 +261,35 @@ instanceExtensions.data()};
             // Get the GPU description and total memory
             // getAdapterDescFromOS();
             vkGetPhysicalDeviceFeatures(physicalDevice, &deviceFeatures);
+            // Optional extensions, enabled only when the selected device supports them
+            memoryBudgetSupported = checkDeviceExtensionSupport(physicalDevice, {VK_EXT_MEMORY_BUDGET_EXTENSION_NAME});
+            if (memoryBudgetSupported) {
+                deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+            if (descriptorBuffer && checkDeviceExtensionSupport(physicalDevice, {VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME})) {
+                auto descriptorBufferFeatures = VkPhysicalDeviceDescriptorBufferFeaturesEXT {
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT,
+                };
+                auto vulkan12Features = VkPhysicalDeviceVulkan12Features {
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+                    .pNext = &descriptorBufferFeatures,
+                };
+                auto features = VkPhysicalDeviceFeatures2 {
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                    .pNext = &vulkan12Features,
+                };
+                vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+                // Descriptors of buffers are written from the buffers device addresses
+                descriptorBufferEnabled = descriptorBufferFeatures.descriptorBuffer && vulkan12Features.bufferDeviceAddress;
+                if (descriptorBufferEnabled) {
+                    deviceExtensions.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+                    auto properties = VkPhysicalDeviceProperties2 {
+                        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                        .pNext = &descriptorBufferProperties,
+                    };
+                    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+                }
+            }
         } else {
             throw Exception("Failed to find a suitable GPU!");
         }
@@ -502,9 +537,14 @@ instanceExtensions.data()};
 
         // Initialize device extensions and create a logical device
         {
+            VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT,
+                .pNext = nullptr,
+                .descriptorBuffer = VK_TRUE,
+            };
             VkPhysicalDeviceSynchronization2FeaturesKHR sync2Features{
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
-                .pNext = nullptr,
+                .pNext = physicalDevice.isDescriptorBufferEnabled() ? &descriptorBufferFeatures : nullptr,
                 .synchronization2 = VK_TRUE
             };
             VkPhysicalDeviceFeatures2 deviceFeatures2 {
@@ -539,6 +579,7 @@ instanceExtensions.data()};
                 .descriptorBindingVariableDescriptorCount = VK_TRUE,
                 .runtimeDescriptorArray = VK_TRUE,
                 .timelineSemaphore = VK_TRUE,
+                .bufferDeviceAddress = physicalDevice.isDescriptorBufferEnabled(),
                 .shaderOutputViewportIndex = VK_TRUE,// VK_EXT_shader_viewport_index_layer
                 .shaderOutputLayer = VK_TRUE, // VK_EXT_shader_viewport_index_layer
             };
@@ -564,6 +605,104 @@ instanceExtensions.data()};
 #endif
             vulkanInitializeDevice(device);
         }
+        memoryAllocator = std::make_unique<VKMemoryAllocator>(
+            physicalDevice.getPhysicalDevice(),
+            device,
+            physicalDevice.isMemoryBudgetSupported(),
+            physicalDevice.isDescriptorBufferEnabled());
+        stagingRing = std::make_unique<VKStagingRing>(device, *memoryAllocator);
+        if (physicalDevice.isDescriptorBufferEnabled()) {
+            descriptorHeap = std::make_unique<VKDescriptorHeap>(
+                device,
+                *memoryAllocator,
+                physicalDevice.getDescriptorBufferProperties());
+        }
+        const auto cacheInfo = VkPipelineCacheCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        };
+        vkCheck(vkCreatePipelineCache(device, &cacheInfo, nullptr, &pipelineCache));
+    }
+
+    VKDevice::PipelineCacheHeader VKDevice::getPipelineCacheHeader() const {
+        const auto& properties = physicalDevice.getDeviceProperties();
+        auto header = PipelineCacheHeader {
+            .magic = PIPELINE_CACHE_MAGIC,
+            .version = PIPELINE_CACHE_VERSION,
+            .vendorID = properties.vendorID,
+            .deviceID = properties.deviceID,
+            .driverVersion = properties.driverVersion,
+        };
+        std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+        return header;
+    }
+
+    uint64_t VKDevice::hashPipelineCacheData(const std::vector<char>& data) {
+        // FNV-1a, only used to detect truncated or corrupted files
+        auto hash = uint64_t{0xcbf29ce484222325};
+        for (const auto c : data) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+        }
+        return hash;
+    }
+
+    bool VKDevice::loadPipelineCache(const std::string& fileName) {
+        assert(!fileName.empty());
+        std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        const auto fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+        auto fileHeader = PipelineCacheHeader{};
+        if (!file.read(reinterpret_cast<char*>(&fileHeader), sizeof(PipelineCacheHeader))) {
+            return false;
+        }
+        const auto header = getPipelineCacheHeader();
+        if (fileHeader.magic != header.magic ||
+            fileHeader.version != header.version ||
+            fileHeader.vendorID != header.vendorID ||
+            fileHeader.deviceID != header.deviceID ||
+            fileHeader.driverVersion != header.driverVersion ||
+            std::memcmp(fileHeader.pipelineCacheUUID, header.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+            // The size comes from the file : checked before the allocation
+            fileHeader.dataSize > fileSize - sizeof(PipelineCacheHeader)) {
+            return false;
+        }
+        auto data = std::vector<char>(fileHeader.dataSize);
+        if (!file.read(data.data(), data.size()) || hashPipelineCacheData(data) != fileHeader.dataHash) {
+            return false;
+        }
+        const auto cacheInfo = VkPipelineCacheCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .initialDataSize = data.size(),
+            .pInitialData = data.data(),
+        };
+        VkPipelineCache loadedCache;
+        if (vkCreatePipelineCache(device, &cacheInfo, nullptr, &loadedCache) != VK_SUCCESS) {
+            return false;
+        }
+        const auto result = vkMergePipelineCaches(device, pipelineCache, 1, &loadedCache);
+        vkDestroyPipelineCache(device, loadedCache, nullptr);
+        return result == VK_SUCCESS;
+    }
+
+    void VKDevice::savePipelineCache(const std::string& fileName) const {
+        assert(!fileName.empty());
+        size_t dataSize;
+        vkCheck(vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr));
+        auto data = std::vector<char>(dataSize);
+        vkCheck(vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data()));
+        data.resize(dataSize);
+
+        auto header = getPipelineCacheHeader();
+        header.dataSize = static_cast<uint32_t>(data.size());
+        header.dataHash = hashPipelineCacheData(data);
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw Exception("failed to open pipeline cache file ", fileName);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(PipelineCacheHeader));
+        file.write(data.data(), data.size());
     }
 
     VkImageView VKDevice::createImageView(
@@ -597,6 +736,10 @@ instanceExtensions.data()};
     }
 
     VKDevice::~VKDevice() {
+        vkDestroyPipelineCache(device, pipelineCache, nullptr);
+        descriptorHeap.reset();
+        stagingRing.reset();
+        memoryAllocator.reset();
         vkDestroyDevice(device, nullptr);
     }
 
@@ -10,6 +10,7 @@ export module vireo.vulkan.devices;
 
 import std;
 import vireo;
+import vireo.vulkan.memory;
 
 export namespace vireo {
 
@@ -43,7 +44,9 @@ export namespace vireo {
             VK_SAMPLE_COUNT_64_BIT,
         };
 
-        VKPhysicalDevice(VkInstance instance);
+        // `descriptorBuffer` : enable VK_EXT_descriptor_buffer if supported
+        // `headless` : do not require VK_KHR_swapchain
+        VKPhysicalDevice(VkInstance instance, bool descriptorBuffer, bool headless);
 
         auto getPhysicalDevice() const { return physicalDevice; }
 
@@ -53,6 +56,14 @@ export namespace vireo {
 
         const auto& getDeviceProperties() const { return deviceProperties.properties; }
 
+        // Returns true if VK_EXT_memory_budget is enabled
+        auto isMemoryBudgetSupported() const { return memoryBudgetSupported; }
+
+        // Returns true if VK_EXT_descriptor_buffer is requested and enabled
+        auto isDescriptorBufferEnabled() const { return descriptorBufferEnabled; }
+
+        const auto& getDescriptorBufferProperties() const { return descriptorBufferProperties; }
+
         struct QueueFamilyIndices {
             std::optional<uint32_t> graphicsFamily;
             std::optional<uint32_t> transferFamily;
@@ -94,6 +105,11 @@ export namespace vireo {
             VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES
         };
         VkSampleCountFlagBits        sampleCount;
+        bool                         memoryBudgetSupported{false};
+        bool                         descriptorBufferEnabled{false};
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties{
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT
+        };
 
         struct SwapChainSupportDetails {
             VkSurfaceCapabilitiesKHR   capabilities;
@@ -134,6 +150,28 @@ export namespace vireo {
             return transferQueueFamilyIndex != graphicsQueueFamilyIndex;
         }
 
+        // Device memory heap used by buffers and images
+        auto& getMemoryAllocator() const { return *memoryAllocator; }
+
+        // Staging memory used by the command lists upload methods
+        auto& getStagingRing() const { return *stagingRing; }
+
+        // Descriptor buffers used by the descriptor sets, nullptr if VK_EXT_descriptor_buffer is not enabled
+        auto getDescriptorHeap() const { return descriptorHeap.get(); }
+
+        // Flags used to create all the pipelines
+        VkPipelineCreateFlags getPipelineCreateFlags() const {
+            return descriptorHeap ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : static_cast<VkPipelineCreateFlags>(0);
+        }
+
+        // Pipeline cache used by all the pipelines created with the device
+        auto getPipelineCache() const { return pipelineCache; }
+
+        // Merges a cache file in the pipeline cache, returns false if the file is missing or invalid
+        bool loadPipelineCache(const std::string& fileName);
+
+        void savePipelineCache(const std::string& fileName) const;
+
         VkImageView createImageView(VkImage            image,
                                     VkFormat           format,
                                     VkImageAspectFlags aspectFlags,
@@ -149,6 +187,31 @@ export namespace vireo {
         uint32_t    graphicsQueueFamilyIndex;
         uint32_t    transferQueueFamilyIndex;
         uint32_t    computeQueueFamilyIndex;
+        std::unique_ptr<VKMemoryAllocator> memoryAllocator;
+        std::unique_ptr<VKStagingRing>     stagingRing;
+        std::unique_ptr<VKDescriptorHeap>  descriptorHeap;
+        VkPipelineCache                    pipelineCache{VK_NULL_HANDLE};
+
+        // Header written before the pipeline cache data in the cache files.
+        // The Vulkan cache header does not include the driver version, a cache written by another driver
+        // version is discarded before being given to the driver.
+        struct PipelineCacheHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+            uint32_t dataSize;
+            uint64_t dataHash;
+        };
+
+        static constexpr uint32_t PIPELINE_CACHE_MAGIC{0x5043564b}; // "KVCP"
+        static constexpr uint32_t PIPELINE_CACHE_VERSION{1};
+
+        PipelineCacheHeader getPipelineCacheHeader() const;
+
+        static uint64_t hashPipelineCacheData(const std::vector<char>& data);
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,546 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include "vireo/backend/vulkan/Libraries.h"
+#include <cassert>
+module vireo.vulkan.memory;
+
+import vireo.tools;
+import vireo.vulkan.tools;
+
+namespace vireo {
+
+    VKMemoryBlock::VKMemoryBlock(
+        const VkDeviceMemory memory,
+        const VkDeviceSize size,
+        void* mappedAddress,
+        const bool dedicated) :
+        memory{memory},
+        size{size},
+        mappedAddress{mappedAddress},
+        dedicated{dedicated} {
+        for (auto& heads : freeHeads) {
+            heads.fill(NONE);
+        }
+        if (!dedicated) {
+            // The whole block starts as a single free region
+            regions.push_back({ .offset = 0, .size = size });
+            insertFree(0);
+        }
+    }
+
+    void VKMemoryBlock::mapping(const VkDeviceSize size, uint32_t& fl, uint32_t& sl) {
+        if (size < SMALL_SIZE) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size / (SMALL_SIZE / SL_COUNT));
+        } else {
+            const auto msb = static_cast<uint32_t>(std::bit_width(size) - 1);
+            sl = static_cast<uint32_t>(size >> (msb - SL_LOG2)) ^ SL_COUNT;
+            fl = msb - FL_SHIFT + 1;
+        }
+    }
+
+    uint32_t VKMemoryBlock::findFree(const VkDeviceSize size) const {
+        // Round the size up to the next list so that any region found is large enough
+        const auto step = size < SMALL_SIZE ?
+            SMALL_SIZE / SL_COUNT :
+            1ull << (std::bit_width(size) - 1 - SL_LOG2);
+        uint32_t fl, sl;
+        mapping(size + step - 1, fl, sl);
+        if (fl >= FL_COUNT) {
+            return NONE;
+        }
+        auto slMap = slBitmaps[fl] & (~0u << sl);
+        if (slMap == 0) {
+            const auto flMap = fl + 1 < FL_COUNT ? flBitmap & (~0ull << (fl + 1)) : 0;
+            if (flMap == 0) {
+                return NONE;
+            }
+            fl = static_cast<uint32_t>(std::countr_zero(flMap));
+            slMap = slBitmaps[fl];
+        }
+        sl = static_cast<uint32_t>(std::countr_zero(slMap));
+        return freeHeads[fl][sl];
+    }
+
+    uint32_t VKMemoryBlock::newRegion() {
+        if (!unusedRegions.empty()) {
+            const auto index = unusedRegions.back();
+            unusedRegions.pop_back();
+            regions[index] = {};
+            return index;
+        }
+        regions.emplace_back();
+        return static_cast<uint32_t>(regions.size() - 1);
+    }
+
+    void VKMemoryBlock::insertFree(const uint32_t region) {
+        uint32_t fl, sl;
+        mapping(regions[region].size, fl, sl);
+        auto& r = regions[region];
+        r.isFree = true;
+        r.prevFree = NONE;
+        r.nextFree = freeHeads[fl][sl];
+        if (r.nextFree != NONE) {
+            regions[r.nextFree].prevFree = region;
+        }
+        freeHeads[fl][sl] = region;
+        flBitmap |= 1ull << fl;
+        slBitmaps[fl] |= 1u << sl;
+    }
+
+    void VKMemoryBlock::removeFree(const uint32_t region) {
+        uint32_t fl, sl;
+        mapping(regions[region].size, fl, sl);
+        auto& r = regions[region];
+        if (r.prevFree != NONE) {
+            regions[r.prevFree].nextFree = r.nextFree;
+        } else {
+            freeHeads[fl][sl] = r.nextFree;
+        }
+        if (r.nextFree != NONE) {
+            regions[r.nextFree].prevFree = r.prevFree;
+        }
+        if (freeHeads[fl][sl] == NONE) {
+            slBitmaps[fl] &= ~(1u << sl);
+            if (slBitmaps[fl] == 0) {
+                flBitmap &= ~(1ull << fl);
+            }
+        }
+        r.isFree = false;
+        r.prevFree = NONE;
+        r.nextFree = NONE;
+    }
+
+    uint32_t VKMemoryBlock::allocate(const VkDeviceSize size, const VkDeviceSize alignment, VkDeviceSize& offset) {
+        assert(!dedicated);
+        assert(size > 0);
+        assert(std::has_single_bit(alignment));
+        const auto index = findFree(size + alignment - 1);
+        if (index == NONE) {
+            return NONE;
+        }
+        removeFree(index);
+
+        const auto alignedOffset = (regions[index].offset + alignment - 1) & ~(alignment - 1);
+        const auto padding = alignedOffset - regions[index].offset;
+        if (padding > 0) {
+            // Free neighbours are always merged, so the previous region is in use :
+            // it takes the alignment padding and will release it with its own range.
+            const auto prev = regions[index].prevPhysical;
+            assert(prev != NONE && !regions[prev].isFree);
+            regions[prev].size += padding;
+            regions[index].offset = alignedOffset;
+            regions[index].size -= padding;
+            used += padding;
+        }
+
+        if (regions[index].size - size >= MIN_SPLIT_SIZE) {
+            const auto remainder = newRegion();
+            auto& current = regions[index];
+            regions[remainder] = {
+                .offset = current.offset + size,
+                .size = current.size - size,
+                .prevPhysical = index,
+                .nextPhysical = current.nextPhysical,
+            };
+            if (current.nextPhysical != NONE) {
+                regions[current.nextPhysical].prevPhysical = remainder;
+            }
+            current.nextPhysical = remainder;
+            current.size = size;
+            insertFree(remainder);
+        }
+
+        used += regions[index].size;
+        offset = regions[index].offset;
+        return index;
+    }
+
+    VkDeviceSize VKMemoryBlock::free(const uint32_t region) {
+        assert(!dedicated);
+        assert(region < regions.size() && !regions[region].isFree);
+        auto index = region;
+        const auto released = regions[index].size;
+        used -= released;
+
+        const auto next = regions[index].nextPhysical;
+        if (next != NONE && regions[next].isFree) {
+            removeFree(next);
+            regions[index].size += regions[next].size;
+            regions[index].nextPhysical = regions[next].nextPhysical;
+            if (regions[next].nextPhysical != NONE) {
+                regions[regions[next].nextPhysical].prevPhysical = index;
+            }
+            unusedRegions.push_back(next);
+        }
+        const auto prev = regions[index].prevPhysical;
+        if (prev != NONE && regions[prev].isFree) {
+            removeFree(prev);
+            regions[prev].size += regions[index].size;
+            regions[prev].nextPhysical = regions[index].nextPhysical;
+            if (regions[index].nextPhysical != NONE) {
+                regions[regions[index].nextPhysical].prevPhysical = prev;
+            }
+            unusedRegions.push_back(index);
+            index = prev;
+        }
+        insertFree(index);
+        return released;
+    }
+
+    VKMemoryAllocator::VKMemoryAllocator(
+        const VkPhysicalDevice physicalDevice,
+        const VkDevice device,
+        const bool memoryBudgetSupported,
+        const bool deviceAddress):
+        physicalDevice{physicalDevice},
+        device{device},
+        memoryBudgetSupported{memoryBudgetSupported},
+        deviceAddress{deviceAddress} {
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        bufferImageGranularity = properties.limits.bufferImageGranularity;
+    }
+
+    VKMemoryAllocator::~VKMemoryAllocator() {
+        for (uint32_t memoryTypeIndex = 0; memoryTypeIndex < VK_MAX_MEMORY_TYPES; memoryTypeIndex++) {
+            for (const auto& typeBlocks : blocks[memoryTypeIndex]) {
+                for (const auto& block : typeBlocks) {
+                    destroyBlock(memoryTypeIndex, *block);
+                }
+            }
+        }
+    }
+
+    uint32_t VKMemoryAllocator::findMemoryType(const uint32_t typeFilter, const VkMemoryPropertyFlags properties) const {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) &&
+                (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) { return i; }
+        }
+        throw Exception("failed to find suitable memory type!");
+    }
+
+    VkDeviceSize VKMemoryAllocator::getPreferredBlockSize(const uint32_t memoryTypeIndex) const {
+        const auto heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+        // Small heaps (like the 256MB BAR) are split in 8 blocks to avoid exhausting them
+        return heapSize <= 1024ull * 1024 * 1024 ? heapSize / 8 : MAX_BLOCK_SIZE;
+    }
+
+    VKMemoryBlock* VKMemoryAllocator::createBlock(
+        std::vector<std::unique_ptr<VKMemoryBlock>>& typeBlocks,
+        const uint32_t memoryTypeIndex,
+        const VkDeviceSize size,
+        const bool dedicated) {
+        const auto flagsInfo = VkMemoryAllocateFlagsInfo {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+            .flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT,
+        };
+        const auto allocInfo = VkMemoryAllocateInfo {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .pNext = deviceAddress ? &flagsInfo : nullptr,
+            .allocationSize = size,
+            .memoryTypeIndex = memoryTypeIndex,
+        };
+        VkDeviceMemory memory;
+        vkCheck(vkAllocateMemory(device, &allocInfo, nullptr, &memory), "VKMemoryAllocator : failed to allocate block");
+        // Host visible blocks are persistently mapped, resources only get a pointer inside the mapping
+        void* mappedAddress{nullptr};
+        if (memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            vkCheck(vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mappedAddress));
+        }
+#ifdef _DEBUG
+        vkSetObjectName(device, reinterpret_cast<uint64_t>(memory), VK_OBJECT_TYPE_DEVICE_MEMORY,
+            "VKMemoryBlock : type " + std::to_string(memoryTypeIndex) + (dedicated ? " (dedicated)" : ""));
+#endif
+        typeBlocks.push_back(std::make_unique<VKMemoryBlock>(memory, size, mappedAddress, dedicated));
+        counters[memoryTypeIndex].allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        counters[memoryTypeIndex].blockCount.fetch_add(1, std::memory_order_relaxed);
+        return typeBlocks.back().get();
+    }
+
+    void VKMemoryAllocator::destroyBlock(const uint32_t memoryTypeIndex, const VKMemoryBlock& block) {
+        if (block.getMappedAddress()) {
+            vkUnmapMemory(device, block.getMemory());
+        }
+        vkFreeMemory(device, block.getMemory(), nullptr);
+        counters[memoryTypeIndex].allocatedBytes.fetch_sub(block.getSize(), std::memory_order_relaxed);
+        counters[memoryTypeIndex].blockCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    VKMemoryAllocation VKMemoryAllocator::allocate(
+        const VkMemoryRequirements& requirements,
+        const VkMemoryPropertyFlags properties,
+        const VKMemoryResourceKind kind) {
+        const auto memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, properties);
+        const auto blockSize = getPreferredBlockSize(memoryTypeIndex);
+        // Without a granularity constraint linear and optimal resources can share blocks
+        const auto kindIndex = bufferImageGranularity > 1 ? static_cast<int>(kind) : 0;
+        const auto alignment = std::max(requirements.alignment, VkDeviceSize{1});
+
+        auto lock = std::lock_guard(mutex);
+        auto& typeBlocks = blocks[memoryTypeIndex][kindIndex];
+        auto allocation = VKMemoryAllocation {
+            .memoryTypeIndex = memoryTypeIndex,
+            .size = requirements.size,
+            .kind = kind,
+        };
+
+        if (requirements.size > blockSize / 2) {
+            // Large resources get their own memory block
+            allocation.block = createBlock(typeBlocks, memoryTypeIndex, requirements.size, true);
+            allocation.offset = 0;
+        } else {
+            for (const auto& block : typeBlocks) {
+                if (block->isDedicated()) { continue; }
+                allocation.region = block->allocate(requirements.size, alignment, allocation.offset);
+                if (allocation.region != VKMemoryBlock::NONE) {
+                    allocation.block = block.get();
+                    break;
+                }
+            }
+            if (allocation.block == nullptr) {
+                auto* block = createBlock(typeBlocks, memoryTypeIndex, blockSize, false);
+                allocation.region = block->allocate(requirements.size, alignment, allocation.offset);
+                if (allocation.region == VKMemoryBlock::NONE) {
+                    throw Exception("VKMemoryAllocator : failed to allocate ", requirements.size, " bytes");
+                }
+                allocation.block = block;
+            }
+        }
+        allocation.memory = allocation.block->getMemory();
+        if (allocation.block->getMappedAddress()) {
+            allocation.mappedAddress = static_cast<char*>(allocation.block->getMappedAddress()) + allocation.offset;
+        }
+        counters[memoryTypeIndex].usedBytes.fetch_add(allocation.size, std::memory_order_relaxed);
+        counters[memoryTypeIndex].allocationCount.fetch_add(1, std::memory_order_relaxed);
+        return allocation;
+    }
+
+    void VKMemoryAllocator::free(const VKMemoryAllocation& allocation) {
+        assert(allocation.block != nullptr);
+        const auto kindIndex = bufferImageGranularity > 1 ? static_cast<int>(allocation.kind) : 0;
+        auto lock = std::lock_guard(mutex);
+        auto& typeBlocks = blocks[allocation.memoryTypeIndex][kindIndex];
+        auto* block = allocation.block;
+        auto release = block->isDedicated();
+        if (!release) {
+            block->free(allocation.region);
+            // Keep one empty block per memory type to avoid allocation churn
+            release = block->isEmpty() &&
+                std::ranges::count_if(typeBlocks, [](const auto& b) { return !b->isDedicated(); }) > 1;
+        }
+        counters[allocation.memoryTypeIndex].usedBytes.fetch_sub(allocation.size, std::memory_order_relaxed);
+        counters[allocation.memoryTypeIndex].allocationCount.fetch_sub(1, std::memory_order_relaxed);
+        if (release) {
+            destroyBlock(allocation.memoryTypeIndex, *block);
+            std::erase_if(typeBlocks, [block](const auto& b) { return b.get() == block; });
+        }
+    }
+
+    MemoryStatistics VKMemoryAllocator::getStatistics() const {
+        auto statistics = MemoryStatistics {
+            .heaps = std::vector<MemoryHeapStatistics>(memoryProperties.memoryHeapCount),
+            .types = std::vector<MemoryTypeStatistics>(memoryProperties.memoryTypeCount),
+        };
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+            statistics.heaps[i].size = memoryProperties.memoryHeaps[i].size;
+            statistics.heaps[i].deviceLocal = memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+        }
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            auto& type = statistics.types[i];
+            type.heapIndex = memoryProperties.memoryTypes[i].heapIndex;
+            type.allocatedBytes = counters[i].allocatedBytes.load(std::memory_order_relaxed);
+            type.usedBytes = counters[i].usedBytes.load(std::memory_order_relaxed);
+            type.blockCount = counters[i].blockCount.load(std::memory_order_relaxed);
+            type.allocationCount = counters[i].allocationCount.load(std::memory_order_relaxed);
+            auto& heap = statistics.heaps[type.heapIndex];
+            heap.allocatedBytes += type.allocatedBytes;
+            heap.usedBytes += type.usedBytes;
+            heap.blockCount += type.blockCount;
+            heap.allocationCount += type.allocationCount;
+        }
+        if (memoryBudgetSupported) {
+            // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_memory_budget.html
+            auto budget = VkPhysicalDeviceMemoryBudgetPropertiesEXT {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT,
+            };
+            auto properties = VkPhysicalDeviceMemoryProperties2 {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+                .pNext = &budget,
+            };
+            vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &properties);
+            for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+                statistics.heaps[i].usage = budget.heapUsage[i];
+                statistics.heaps[i].budget = budget.heapBudget[i];
+            }
+        }
+        return statistics;
+    }
+
+    VKStagingRing::VKStagingRing(const VkDevice device, VKMemoryAllocator& allocator, const VkDeviceSize capacity):
+        device{device},
+        allocator{allocator},
+        capacity{capacity} {
+        const auto bufferInfo = VkBufferCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = capacity,
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        };
+        vkCheck(vkCreateBuffer(device, &bufferInfo, nullptr, &buffer));
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+        memory = allocator.allocate(
+            memRequirements,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            VKMemoryResourceKind::LINEAR);
+        vkCheck(vkBindBufferMemory(device, buffer, memory.memory, memory.offset));
+#ifdef _DEBUG
+        vkSetObjectName(device, reinterpret_cast<uint64_t>(buffer), VK_OBJECT_TYPE_BUFFER, "VKStagingRing");
+#endif
+    }
+
+    VKStagingRing::~VKStagingRing() {
+        vkDestroyBuffer(device, buffer, nullptr);
+        allocator.free(memory);
+    }
+
+    bool VKStagingRing::allocate(const VkDeviceSize size, const VkDeviceSize alignment, VKStagingAllocation& allocation) {
+        assert(size > 0);
+        assert(alignment > 0);
+        if (size > getMaxAllocationSize()) {
+            return false;
+        }
+        auto lock = std::lock_guard(mutex);
+        auto offset = (head + alignment - 1) / alignment * alignment;
+        if (offset + size > capacity) {
+            // Skip the end of the ring and wrap around
+            offset = 0;
+        }
+        const auto charged = offset == 0 && head != 0 ?
+            capacity - head + size :
+            offset - head + size;
+        if (used + charged > capacity) {
+            return false;
+        }
+        head = (offset + size) % capacity;
+        used += charged;
+        ranges.push_back({ .size = charged });
+        allocation.buffer = buffer;
+        allocation.offset = offset;
+        allocation.mappedAddress = static_cast<char*>(memory.mappedAddress) + offset;
+        allocation.ticket = firstTicket + ranges.size() - 1;
+        return true;
+    }
+
+    void VKStagingRing::release(const uint64_t ticket) {
+        auto lock = std::lock_guard(mutex);
+        assert(ticket >= firstTicket && ticket - firstTicket < ranges.size());
+        ranges[ticket - firstTicket].released = true;
+        // Retire the oldest ranges, a range still in use keeps all the following ones alive
+        while (!ranges.empty() && ranges.front().released) {
+            used -= ranges.front().size;
+            ranges.pop_front();
+            firstTicket++;
+        }
+        if (ranges.empty()) {
+            head = 0;
+        }
+    }
+
+    VKDescriptorHeap::VKDescriptorHeap(
+        const VkDevice device,
+        VKMemoryAllocator& allocator,
+        const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties):
+        device{device},
+        allocator{allocator},
+        properties{properties} {
+        createBuffer(
+            RESOURCES_BUFFER,
+            std::min(RESOURCES_CAPACITY, properties.maxResourceDescriptorBufferRange),
+            VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT);
+        createBuffer(
+            SAMPLERS_BUFFER,
+            std::min(SAMPLERS_CAPACITY, properties.maxSamplerDescriptorBufferRange),
+            VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT);
+    }
+
+    VKDescriptorHeap::~VKDescriptorHeap() {
+        for (auto& heapBuffer : buffers) {
+            vkDestroyBuffer(device, heapBuffer.buffer, nullptr);
+            allocator.free(heapBuffer.memory);
+        }
+    }
+
+    void VKDescriptorHeap::createBuffer(const uint32_t index, const VkDeviceSize capacity, const VkBufferUsageFlags usage) {
+        auto& heapBuffer = buffers[index];
+        const auto bufferInfo = VkBufferCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = capacity,
+            .usage = usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        };
+        vkCheck(vkCreateBuffer(device, &bufferInfo, nullptr, &heapBuffer.buffer));
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, heapBuffer.buffer, &memRequirements);
+        heapBuffer.memory = allocator.allocate(
+            memRequirements,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            VKMemoryResourceKind::LINEAR);
+        vkCheck(vkBindBufferMemory(device, heapBuffer.buffer, heapBuffer.memory.memory, heapBuffer.memory.offset));
+        heapBuffer.ranges = std::make_unique<VKMemoryBlock>(
+            heapBuffer.memory.memory,
+            capacity,
+            heapBuffer.memory.mappedAddress,
+            false);
+        const auto addressInfo = VkBufferDeviceAddressInfo {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .buffer = heapBuffer.buffer,
+        };
+        bindingInfos[index] = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+            .address = vkGetBufferDeviceAddress(device, &addressInfo),
+            .usage = usage,
+        };
+#ifdef _DEBUG
+        vkSetObjectName(device, reinterpret_cast<uint64_t>(heapBuffer.buffer), VK_OBJECT_TYPE_BUFFER,
+            index == SAMPLERS_BUFFER ? "VKDescriptorHeap : samplers" : "VKDescriptorHeap : resources");
+#endif
+    }
+
+    VKDescriptorRange VKDescriptorHeap::allocate(const VkDeviceSize size, const bool samplers) {
+        auto lock = std::lock_guard(mutex);
+        auto& heapBuffer = buffers[samplers ? SAMPLERS_BUFFER : RESOURCES_BUFFER];
+        auto range = VKDescriptorRange{ .samplers = samplers };
+        range.region = heapBuffer.ranges->allocate(size, properties.descriptorBufferOffsetAlignment, range.offset);
+        if (range.region == VKMemoryBlock::NONE) {
+            throw Exception("VKDescriptorHeap : descriptor buffer is full");
+        }
+        range.mappedAddress = static_cast<char*>(heapBuffer.memory.mappedAddress) + range.offset;
+        return range;
+    }
+
+    void VKDescriptorHeap::free(const VKDescriptorRange& range) {
+        // Like a set freed with vkFreeDescriptorSets the range must not be used by commands in flight
+        auto lock = std::lock_guard(mutex);
+        buffers[range.samplers ? SAMPLERS_BUFFER : RESOURCES_BUFFER].ranges->free(range.region);
+    }
+
+    size_t VKDescriptorHeap::getDescriptorSize(const VkDescriptorType type) const {
+        switch (type) {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER: return properties.uniformBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: return properties.storageBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:  return properties.sampledImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:  return properties.storageImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLER:        return properties.samplerDescriptorSize;
+            default: throw Exception("VKDescriptorHeap : unsupported descriptor type");
+        }
+    }
+
+}
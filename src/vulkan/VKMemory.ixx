@@ -0,0 +1,276 @@
+/*
+* Copyright (c) 2025-present Henri Michelon
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+module;
+#include "vireo/backend/vulkan/Libraries.h"
+export module vireo.vulkan.memory;
+
+import std;
+import vireo;
+
+export namespace vireo {
+
+    // Kind of resource placed in a memory block.
+    // Linear (buffers) and optimal (images) resources are kept in separate blocks when
+    // bufferImageGranularity > 1 so that neighbours never share a granularity page.
+    enum class VKMemoryResourceKind : uint8_t {
+        LINEAR  = 0,
+        OPTIMAL = 1,
+    };
+
+    // Two-level segregated fit (TLSF) sub-allocator for one VkDeviceMemory block.
+    // All operations are O(1), regions are tracked by index in a recycled vector.
+    class VKMemoryBlock {
+    public:
+        static constexpr auto NONE = std::numeric_limits<uint32_t>::max();
+
+        VKMemoryBlock(VkDeviceMemory memory, VkDeviceSize size, void* mappedAddress, bool dedicated);
+
+        // Returns the region index and the aligned offset, or NONE if the block is too fragmented
+        uint32_t allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+
+        // Returns the number of bytes released
+        VkDeviceSize free(uint32_t region);
+
+        auto getMemory() const { return memory; }
+
+        auto getSize() const { return size; }
+
+        auto getUsed() const { return used; }
+
+        auto getMappedAddress() const { return mappedAddress; }
+
+        auto isDedicated() const { return dedicated; }
+
+        auto isEmpty() const { return used == 0; }
+
+    private:
+        static constexpr uint32_t     SL_LOG2{5};
+        static constexpr uint32_t     SL_COUNT{1u << SL_LOG2};
+        static constexpr uint32_t     FL_SHIFT{8};
+        static constexpr VkDeviceSize SMALL_SIZE{1ull << FL_SHIFT};
+        static constexpr uint32_t     FL_COUNT{64 - FL_SHIFT + 1};
+        // Remainders smaller than this are left inside the allocated region instead of being split
+        static constexpr VkDeviceSize MIN_SPLIT_SIZE{64};
+
+        struct Region {
+            VkDeviceSize offset{0};
+            VkDeviceSize size{0};
+            uint32_t     prevPhysical{NONE};
+            uint32_t     nextPhysical{NONE};
+            uint32_t     prevFree{NONE};
+            uint32_t     nextFree{NONE};
+            bool         isFree{false};
+        };
+
+        VkDeviceMemory        memory;
+        VkDeviceSize          size;
+        VkDeviceSize          used{0};
+        void*                 mappedAddress;
+        bool                  dedicated;
+        std::vector<Region>   regions;
+        std::vector<uint32_t> unusedRegions;
+        uint64_t              flBitmap{0};
+        std::array<uint32_t, FL_COUNT> slBitmaps{};
+        std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> freeHeads;
+
+        static void mapping(VkDeviceSize size, uint32_t& fl, uint32_t& sl);
+
+        uint32_t findFree(VkDeviceSize size) const;
+
+        uint32_t newRegion();
+
+        void insertFree(uint32_t region);
+
+        void removeFree(uint32_t region);
+    };
+
+    // A sub-range of a memory block owned by a buffer or an image
+    struct VKMemoryAllocation {
+        VKMemoryBlock* block{nullptr};
+        uint32_t       region{VKMemoryBlock::NONE};
+        uint32_t       memoryTypeIndex{0};
+        VkDeviceMemory memory{VK_NULL_HANDLE};
+        VkDeviceSize   offset{0};
+        VkDeviceSize   size{0};
+        VKMemoryResourceKind kind{VKMemoryResourceKind::LINEAR};
+        // Persistent mapping of the sub-range for host visible memory types, nullptr otherwise
+        void*          mappedAddress{nullptr};
+    };
+
+    // Per-device memory heap : large blocks are allocated per memory type
+    // and resources are placed inside them with a TLSF sub-allocator.
+    class VKMemoryAllocator {
+    public:
+        // With `deviceAddress` all the blocks are allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+        VKMemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, bool memoryBudgetSupported, bool deviceAddress);
+
+        ~VKMemoryAllocator();
+
+        VKMemoryAllocation allocate(
+            const VkMemoryRequirements& requirements,
+            VkMemoryPropertyFlags properties,
+            VKMemoryResourceKind kind);
+
+        void free(const VKMemoryAllocation& allocation);
+
+        uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+
+        const auto& getMemoryProperties() const { return memoryProperties; }
+
+        // Lock-free snapshot of the counters, with the driver budget if VK_EXT_memory_budget is enabled
+        MemoryStatistics getStatistics() const;
+
+        VKMemoryAllocator(VKMemoryAllocator&) = delete;
+        VKMemoryAllocator& operator=(VKMemoryAllocator&) = delete;
+
+    private:
+        static constexpr VkDeviceSize MAX_BLOCK_SIZE{256ull * 1024 * 1024};
+
+        // Per memory type counters, updated under the allocator mutex but read without it
+        struct Counters {
+            std::atomic<uint64_t> allocatedBytes{0};
+            std::atomic<uint64_t> usedBytes{0};
+            std::atomic<uint32_t> blockCount{0};
+            std::atomic<uint32_t> allocationCount{0};
+        };
+
+        VkPhysicalDevice                 physicalDevice;
+        VkDevice                         device;
+        const bool                       memoryBudgetSupported;
+        const bool                       deviceAddress;
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        VkDeviceSize                     bufferImageGranularity;
+        std::mutex                       mutex;
+        // Blocks per memory type and resource kind
+        std::array<std::array<std::vector<std::unique_ptr<VKMemoryBlock>>, 2>, VK_MAX_MEMORY_TYPES> blocks;
+        std::array<Counters, VK_MAX_MEMORY_TYPES> counters;
+
+        VkDeviceSize getPreferredBlockSize(uint32_t memoryTypeIndex) const;
+
+        VKMemoryBlock* createBlock(
+            std::vector<std::unique_ptr<VKMemoryBlock>>& typeBlocks,
+            uint32_t memoryTypeIndex,
+            VkDeviceSize size,
+            bool dedicated);
+
+        void destroyBlock(uint32_t memoryTypeIndex, const VKMemoryBlock& block);
+    };
+
+    // A sub-range of the staging ring, recorded into a command list for a single upload
+    struct VKStagingAllocation {
+        static constexpr auto DEDICATED = std::numeric_limits<uint64_t>::max();
+
+        VkBuffer     buffer{VK_NULL_HANDLE};
+        VkDeviceSize offset{0};
+        void*        mappedAddress{nullptr};
+        // Ticket used to release the range, DEDICATED for uploads done with a dedicated buffer
+        uint64_t     ticket{DEDICATED};
+    };
+
+    // Per-device persistently mapped staging buffer, sub-allocated linearly.
+    // Ranges are retired in allocation order once released by the command list which used them.
+    class VKStagingRing {
+    public:
+        static constexpr VkDeviceSize DEFAULT_CAPACITY{64ull * 1024 * 1024};
+
+        VKStagingRing(VkDevice device, VKMemoryAllocator& allocator, VkDeviceSize capacity = DEFAULT_CAPACITY);
+
+        ~VKStagingRing();
+
+        // Returns false if the upload is too large or if the ring is full
+        bool allocate(VkDeviceSize size, VkDeviceSize alignment, VKStagingAllocation& allocation);
+
+        void release(uint64_t ticket);
+
+        auto getCapacity() const { return capacity; }
+
+        // Uploads larger than this use a dedicated staging buffer
+        auto getMaxAllocationSize() const { return capacity / 4; }
+
+        VKStagingRing(VKStagingRing&) = delete;
+        VKStagingRing& operator=(VKStagingRing&) = delete;
+
+    private:
+        struct Range {
+            // Bytes charged to the range, including alignment padding and the skipped end of the ring
+            VkDeviceSize size;
+            bool         released{false};
+        };
+
+        const VkDevice     device;
+        VKMemoryAllocator& allocator;
+        const VkDeviceSize capacity;
+        VkBuffer           buffer{VK_NULL_HANDLE};
+        VKMemoryAllocation memory{};
+        std::mutex         mutex;
+        VkDeviceSize       head{0};
+        VkDeviceSize       used{0};
+        uint64_t           firstTicket{0};
+        std::deque<Range>  ranges;
+    };
+
+    // A range of a descriptor heap buffer holding the descriptors of one set
+    struct VKDescriptorRange {
+        uint32_t     region{VKMemoryBlock::NONE};
+        VkDeviceSize offset{0};
+        void*        mappedAddress{nullptr};
+        bool         samplers{false};
+    };
+
+    // Per-device descriptor buffers used with VK_EXT_descriptor_buffer : one buffer for the resources descriptors
+    // and one for the samplers descriptors. Descriptor sets are ranges of these persistently mapped buffers,
+    // sub-allocated with the TLSF allocator of a memory block.
+    class VKDescriptorHeap {
+    public:
+        static constexpr VkDeviceSize RESOURCES_CAPACITY{32ull * 1024 * 1024};
+        static constexpr VkDeviceSize SAMPLERS_CAPACITY{1024ull * 1024};
+        // Index of the buffers in the binding infos
+        static constexpr uint32_t     RESOURCES_BUFFER{0};
+        static constexpr uint32_t     SAMPLERS_BUFFER{1};
+
+        VKDescriptorHeap(
+            VkDevice device,
+            VKMemoryAllocator& allocator,
+            const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties);
+
+        ~VKDescriptorHeap();
+
+        // Throws if the heap is full
+        VKDescriptorRange allocate(VkDeviceSize size, bool samplers);
+
+        void free(const VKDescriptorRange& range);
+
+        const auto& getProperties() const { return properties; }
+
+        // Size of one descriptor of the given type in the descriptor buffers
+        size_t getDescriptorSize(VkDescriptorType type) const;
+
+        // Used by vkCmdBindDescriptorBuffersEXT, indexed by RESOURCES_BUFFER and SAMPLERS_BUFFER
+        const auto& getBindingInfos() const { return bindingInfos; }
+
+        VKDescriptorHeap(VKDescriptorHeap&) = delete;
+        VKDescriptorHeap& operator=(VKDescriptorHeap&) = delete;
+
+    private:
+        struct HeapBuffer {
+            VkBuffer                       buffer{VK_NULL_HANDLE};
+            VKMemoryAllocation             memory{};
+            // Only used for its TLSF sub-allocator, the memory belongs to the device memory allocator
+            std::unique_ptr<VKMemoryBlock> ranges;
+        };
+
+        const VkDevice                                  device;
+        VKMemoryAllocator&                              allocator;
+        const VkPhysicalDeviceDescriptorBufferPropertiesEXT properties;
+        std::mutex                                      mutex;
+        std::array<HeapBuffer, 2>                       buffers;
+        std::array<VkDescriptorBufferBindingInfoEXT, 2> bindingInfos;
+
+        void createBuffer(uint32_t index, VkDeviceSize capacity, VkBufferUsageFlags usage);
+    };
+
+}
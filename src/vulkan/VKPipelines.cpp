@@ -10,6 +10,7 @@ module;
 module vireo.vulkan.pipelines;
 
 import std;
+import vireo.profiler;
 import vireo.tools;
 import vireo.vulkan.devices;
 import vireo.vulkan.resources;
@@ -35,14 +36,13 @@ namespace vireo {
         device{device} {
         assert(device != VK_NULL_HANDLE);
         assert(!fileName.empty());
-        std::ifstream file(fileName + ".spv", std::ios::ate | std::ios::binary);
-        if (!file.is_open()) {
-            throw Exception("failed to open shader file ", fileName);
+        // The mapped file is given directly to the driver, which copies the code in the shader module
+        const auto file = MappedFile(fileName + ".spv");
+        // SPIR-V is a stream of 32 bits words
+        if (file.getSize() == 0 || file.getSize() % sizeof(uint32_t) != 0) {
+            throw Exception("invalid SPIR-V shader file ", fileName);
         }
-        const auto fileSize = static_cast<size_t>(file.tellg());
-        file.seekg(0);
-        load(file, fileSize, fileName);
-        file.close();
+        create({ reinterpret_cast<const uint32_t*>(file.getData()), file.getSize() / sizeof(uint32_t) }, fileName);
     }
 
     VKShaderModule::VKShaderModule(const VkDevice device, std::ifstream inputStream, const size_t size) :
@@ -52,26 +52,38 @@ namespace vireo {
     }
 
     void VKShaderModule::load(std::ifstream& inputStream, const size_t size, const std::string& fileName) {
-        std::vector<char> buffer(size);
-        inputStream.read(buffer.data(), size);
-        const auto createInfo = VkShaderModuleCreateInfo {
-            .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            .codeSize = buffer.size(),
-            .pCode = reinterpret_cast<const uint32_t*>(buffer.data()),
-        };
-        vkCheck(vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule));
-#ifdef _DEBUG
-        vkSetObjectName(device, reinterpret_cast<uint64_t>(shaderModule), VK_OBJECT_TYPE_SHADER_MODULE,
-            "VKShaderModule : " + fileName);
-#endif
+        if (size == 0 || size % sizeof(uint32_t) != 0) {
+            throw Exception("invalid SPIR-V shader file ", fileName);
+        }
+        std::vector<uint32_t> buffer(size / sizeof(uint32_t));
+        inputStream.read(reinterpret_cast<char*>(buffer.data()), size);
+        if (!inputStream) {
+            throw Exception("error reading SPIR-V shader file ", fileName);
+        }
+        create(buffer, fileName);
     }
 
     VKShaderModule::VKShaderModule(const VkDevice device, const std::vector<char>& data, const std::string& name) :
         device{device} {
+        assert(device != VK_NULL_HANDLE);
+        if (data.empty() || data.size() % sizeof(uint32_t) != 0) {
+            throw Exception("invalid SPIR-V shader code ", name);
+        }
+        create({ reinterpret_cast<const uint32_t*>(data.data()), data.size() / sizeof(uint32_t) }, name);
+    }
+
+    VKShaderModule::VKShaderModule(const VkDevice device, const std::span<const uint32_t> code, const std::string& name) :
+        device{device} {
+        assert(device != VK_NULL_HANDLE);
+        create(code, name);
+    }
+
+    void VKShaderModule::create(const std::span<const uint32_t> code, const std::string& name) {
+        assert(!code.empty());
         const auto createInfo = VkShaderModuleCreateInfo {
             .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            .codeSize = data.size(),
-            .pCode = reinterpret_cast<const uint32_t*>(data.data()),
+            .codeSize = code.size_bytes(),
+            .pCode = code.data(),
         };
         vkCheck(vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule));
 #ifdef _DEBUG
@@ -80,7 +92,6 @@ namespace vireo {
 #endif
     }
 
-
     VKShaderModule::~VKShaderModule() {
         vkDestroyShaderModule(device, shaderModule, nullptr);
     }
@@ -133,11 +144,14 @@ namespace vireo {
 
     VKComputePipeline::VKComputePipeline(
           const VkDevice device,
+          const VkPipelineCache pipelineCache,
+          const VkPipelineCreateFlags flags,
           const std::shared_ptr<PipelineResources>& pipelineResources,
           const std::shared_ptr<const ShaderModule>& shader,
           const std::string& name) :
         ComputePipeline{pipelineResources},
         device{device} {
+        const auto zone = CPUProfiler::Zone{"VKComputePipeline"};
         assert(device != VK_NULL_HANDLE);
         assert(shader != nullptr);
         const auto shaderModule = static_pointer_cast<const VKShaderModule>(shader)->getShaderModule();
@@ -154,10 +168,11 @@ namespace vireo {
         };
         const auto createInfo = VkComputePipelineCreateInfo {
             .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .flags = flags,
             .stage = shaderStage,
             .layout = pipelineLayout,
         };
-        vkCheck(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline));
+        vkCheck(vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, &pipeline));
 #ifdef _DEBUG
         vkSetObjectName(device, reinterpret_cast<uint64_t>(pipeline), VK_OBJECT_TYPE_PIPELINE,
             "VKComputePipeline : " + name);
@@ -174,6 +189,7 @@ namespace vireo {
            const std::string& name):
         GraphicPipeline{configuration.resources},
         device{device} {
+        const auto zone = CPUProfiler::Zone{"VKGraphicPipeline"};
         assert(configuration.resources != nullptr);
         assert(configuration.vertexShader != nullptr);
         assert(configuration.colorRenderFormats.size() == configuration.colorBlendDesc.size());
@@ -327,7 +343,7 @@ namespace vireo {
         const auto pipelineInfo = VkGraphicsPipelineCreateInfo {
             .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
             .pNext = &dynamicRenderingCreateInfo,
-            .flags = 0,
+            .flags = device->getPipelineCreateFlags(),
             .stageCount = static_cast<uint32_t>(shaderStages.size()),
             .pStages = shaderStages.data(),
             .pVertexInputState = &vertexInputInfo,
@@ -344,7 +360,7 @@ namespace vireo {
             .basePipelineHandle = VK_NULL_HANDLE,
             .basePipelineIndex = -1,
         };
-        vkCheck(vkCreateGraphicsPipelines(device->getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline));
+        vkCheck(vkCreateGraphicsPipelines(device->getDevice(), device->getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline));
 #ifdef _DEBUG
         vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(pipeline), VK_OBJECT_TYPE_PIPELINE,
             "VKGraphicPipeline : " + name);
@@ -52,6 +52,8 @@ export namespace vireo {
 
         VKShaderModule(VkDevice device, const std::vector<char>& data, const std::string& name);
 
+        VKShaderModule(VkDevice device, std::span<const uint32_t> code, const std::string& name);
+
         ~VKShaderModule() override;
 
         auto getShaderModule() const { return shaderModule; }
@@ -61,6 +63,8 @@ export namespace vireo {
         VkShaderModule shaderModule;
 
         void load(std::ifstream& inputStream, size_t size, const std::string& fileName);
+
+        void create(std::span<const uint32_t> code, const std::string& name);
     };
 
     class VKPipelineResources : public PipelineResources {
@@ -87,6 +91,8 @@ export namespace vireo {
     public:
         VKComputePipeline(
            VkDevice device,
+           VkPipelineCache pipelineCache,
+           VkPipelineCreateFlags flags,
            const std::shared_ptr<PipelineResources>& pipelineResources,
            const std::shared_ptr<const ShaderModule>& shader,
            const std::string& name);
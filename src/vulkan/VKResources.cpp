@@ -33,7 +33,7 @@ namespace vireo {
         instanceSize = size;
         instanceCount = count;
 
-        const VkBufferCreateFlags usage =
+        VkBufferUsageFlags usage =
             type == BufferType::VERTEX ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT :
             type == BufferType::INDEX ? VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT:
             type == BufferType::INDIRECT ? VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT:
@@ -53,10 +53,20 @@ namespace vireo {
             type == BufferType::READWRITE_STORAGE) ?
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT :
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        createBuffer(device, bufferSize, usage, memType, buffer, bufferMemory);
+        // Descriptors of buffers are written from their addresses in the descriptor buffers
+        if (device->getDescriptorHeap()) {
+            usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        }
+        createBuffer(device, bufferSize, usage, memType, buffer, allocation);
+        if (device->getDescriptorHeap()) {
+            const auto addressInfo = VkBufferDeviceAddressInfo {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+                .buffer = buffer,
+            };
+            deviceAddress = vkGetBufferDeviceAddress(device->getDevice(), &addressInfo);
+        }
         if constexpr (isMemoryUsageEnabled()) {
-            auto lock = std::lock_guard(memoryAllocationsMutex);
-            memoryAllocations.push_back({
+            addMemoryAllocation({
                 VideoMemoryAllocationUsage::BUFFER,
                 name,
                 bufferSize,
@@ -65,19 +75,18 @@ namespace vireo {
 #ifdef _DEBUG
         vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(buffer), VK_OBJECT_TYPE_BUFFER,
             "VKBuffer : " + name);
-        vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(bufferMemory), VK_OBJECT_TYPE_DEVICE_MEMORY,
-        "VKBuffer Memory : " + name);
 #endif
     }
 
     void VKBuffer::map() {
         assert(mappedAddress == nullptr);
-        vkMapMemory(device->getDevice(), bufferMemory, 0, bufferSize, 0, &mappedAddress);
+        // Host visible memory blocks are persistently mapped by the device memory allocator
+        assert(allocation.mappedAddress != nullptr);
+        mappedAddress = allocation.mappedAddress;
     }
 
     void VKBuffer::unmap() {
         assert(mappedAddress != nullptr);
-        vkUnmapMemory(device->getDevice(), bufferMemory);
         mappedAddress = nullptr;
     }
 
@@ -85,9 +94,9 @@ namespace vireo {
             const std::shared_ptr<const VKDevice>& device,
             const VkDeviceSize size,
             const VkBufferUsageFlags usage,
-            const VkMemoryPropertyFlags memoryTypeIndex,
+            const VkMemoryPropertyFlags memoryProperties,
             VkBuffer& buffer,
-            VkDeviceMemory& memory) {
+            VKMemoryAllocation& allocation) {
         const auto bufferInfo = VkBufferCreateInfo {
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             .size = size,
@@ -97,27 +106,19 @@ namespace vireo {
         vkCheck(vkCreateBuffer(device->getDevice(), &bufferInfo, nullptr, &buffer));
         VkMemoryRequirements memRequirements;
         vkGetBufferMemoryRequirements(device->getDevice(), buffer, &memRequirements);
-        const auto allocInfo = VkMemoryAllocateInfo {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = memRequirements.size,
-            .memoryTypeIndex = device->getPhysicalDevice().findMemoryType(memRequirements.memoryTypeBits, memoryTypeIndex)
-        };
-        vkCheck(vkAllocateMemory(device->getDevice(), &allocInfo, nullptr, &memory));
-        vkBindBufferMemory(device->getDevice(), buffer, memory, 0);
+        allocation = device->getMemoryAllocator().allocate(
+            memRequirements,
+            memoryProperties,
+            VKMemoryResourceKind::LINEAR);
+        vkCheck(vkBindBufferMemory(device->getDevice(), buffer, allocation.memory, allocation.offset));
     }
 
     VKBuffer::~VKBuffer() {
         if (mappedAddress) {
             VKBuffer::unmap();
         }
-        // if constexpr(isMemoryUsageEnabled()) {
-            // auto lock = std::lock_guard(memoryAllocationsMutex);
-            // memoryAllocations.remove_if([&](const VideoMemoryAllocationDesc& usage) {
-                // return usage.ref == buffer;
-            // });
-        // }
         vkDestroyBuffer(device->getDevice(), buffer, nullptr);
-        vkFreeMemory(device->getDevice(), bufferMemory, nullptr);
+        device->getMemoryAllocator().free(allocation);
     }
 
     VKSampler::VKSampler(
@@ -160,6 +161,108 @@ namespace vireo {
         vkDestroySampler(device, sampler, nullptr);
     }
 
+    VKTransientMemory::VKTransientMemory(
+        const std::shared_ptr<const VKDevice>& device,
+        const std::vector<Resource>& resources):
+        device{device},
+        placements(resources.size()) {
+        auto& allocator = device->getMemoryAllocator();
+        auto order = std::vector<uint32_t>{};
+        for (uint32_t i = 0; i < resources.size(); i++) {
+            const auto& resource = resources[i];
+            assert(resource.firstUse <= resource.lastUse);
+            if (resource.lazy && hasLazyMemoryType(resource.requirements.memoryTypeBits)) {
+                // Lazily allocated memory is not backed on tiled GPUs, aliasing is useless
+                allocations.push_back(allocator.allocate(
+                    resource.requirements,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT,
+                    VKMemoryResourceKind::OPTIMAL));
+                placements[i] = { allocations.back().memory, allocations.back().offset };
+            } else {
+                order.push_back(i);
+            }
+        }
+
+        // Interval graph colouring : intervals sorted by start are assigned to the first compatible
+        // slot already free, choosing the one which grows the least
+        std::ranges::sort(order, [&](const uint32_t a, const uint32_t b) {
+            if (resources[a].firstUse != resources[b].firstUse) {
+                return resources[a].firstUse < resources[b].firstUse;
+            }
+            return resources[a].requirements.size > resources[b].requirements.size;
+        });
+        auto slots = std::vector<Slot>{};
+        for (const auto index : order) {
+            const auto& resource = resources[index];
+            Slot* best{nullptr};
+            for (auto& slot : slots) {
+                if (slot.memoryTypeBits != resource.requirements.memoryTypeBits ||
+                    slot.lastUse >= resource.firstUse) { continue; }
+                const auto growth = resource.requirements.size > slot.size ? resource.requirements.size - slot.size : 0;
+                const auto bestGrowth = best == nullptr ? std::numeric_limits<VkDeviceSize>::max() :
+                    resource.requirements.size > best->size ? resource.requirements.size - best->size : 0;
+                if (growth < bestGrowth || (growth == bestGrowth && best != nullptr && slot.size < best->size)) {
+                    best = &slot;
+                }
+            }
+            if (best == nullptr) {
+                best = &slots.emplace_back(Slot{
+                    .memoryTypeBits = resource.requirements.memoryTypeBits,
+                    .lastUse = resource.lastUse,
+                });
+            }
+            best->size = std::max(best->size, resource.requirements.size);
+            best->alignment = std::max(best->alignment, resource.requirements.alignment);
+            best->lastUse = resource.lastUse;
+            best->resources.push_back(index);
+        }
+
+        // One memory range per memory type filter, slots placed one after the other
+        auto memoryTypeBits = std::vector<uint32_t>{};
+        for (const auto& slot : slots) {
+            if (std::ranges::find(memoryTypeBits, slot.memoryTypeBits) == memoryTypeBits.end()) {
+                memoryTypeBits.push_back(slot.memoryTypeBits);
+            }
+        }
+        for (const auto typeBits : memoryTypeBits) {
+            auto requirements = VkMemoryRequirements{ .size = 0, .alignment = 1, .memoryTypeBits = typeBits };
+            for (auto& slot : slots) {
+                if (slot.memoryTypeBits != typeBits) { continue; }
+                slot.offset = (requirements.size + slot.alignment - 1) & ~(slot.alignment - 1);
+                requirements.size = slot.offset + slot.size;
+                requirements.alignment = std::max(requirements.alignment, slot.alignment);
+            }
+            allocations.push_back(allocator.allocate(
+                requirements,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                VKMemoryResourceKind::OPTIMAL));
+            const auto& allocation = allocations.back();
+            for (const auto& slot : slots) {
+                if (slot.memoryTypeBits != typeBits) { continue; }
+                for (const auto index : slot.resources) {
+                    placements[index] = { allocation.memory, allocation.offset + slot.offset };
+                }
+            }
+        }
+    }
+
+    VKTransientMemory::~VKTransientMemory() {
+        for (const auto& allocation : allocations) {
+            device->getMemoryAllocator().free(allocation);
+        }
+    }
+
+    bool VKTransientMemory::hasLazyMemoryType(const uint32_t typeFilter) const {
+        const auto& memoryProperties = device->getMemoryAllocator().getMemoryProperties();
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) &&
+                (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     VKImage::VKImage(
         const std::shared_ptr<const VKDevice>& device,
         const ImageFormat format,
@@ -184,22 +287,72 @@ namespace vireo {
             isRenderTarget ?
                 isDepthBuffer ?
                     VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
-                    : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT:
+                    : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                      VK_IMAGE_USAGE_SAMPLED_BIT:
             useByComputeShader ?
                 VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT |
                 VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
                 VK_IMAGE_USAGE_SAMPLED_BIT :
             VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        createImage(usage, msaa);
+
+        const auto memRequirements = getMemoryRequirements();
+        allocation = device->getMemoryAllocator().allocate(
+            memRequirements,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            VKMemoryResourceKind::OPTIMAL);
+        vkCheck(vkBindImageMemory(device->getDevice(), image, allocation.memory, allocation.offset));
+        if constexpr (isMemoryUsageEnabled()) {
+            addMemoryAllocation({
+                VideoMemoryAllocationUsage::IMAGE,
+                name,
+                memRequirements.size,
+                image });
+        }
+        createImageView();
+    }
+
+    VKImage::VKImage(
+        const std::shared_ptr<const VKDevice>& device,
+        const ImageFormat format,
+        const uint32_t    width,
+        const uint32_t    height,
+        const uint32_t    arraySize,
+        const std::string&    name,
+        const bool        isDepthBuffer,
+        const bool        isDepthBufferWithStencil,
+        const MSAA        msaa,
+        const bool        transientAttachment):
+        Image{format, width, height, 1, arraySize, false, name},
+        device{device},
+        aspect{isDepthBuffer ?
+           isDepthBufferWithStencil ?
+           VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT:
+           VK_IMAGE_ASPECT_DEPTH_BIT :
+           VK_IMAGE_ASPECT_COLOR_BIT} {
+        const VkImageUsageFlags attachment =
+            isDepthBuffer ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        // Transient attachments can't be combined with any other usage
+        createImage(
+            transientAttachment ?
+                attachment | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT :
+                attachment | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            msaa);
+    }
+
+    void VKImage::createImage(const VkImageUsageFlags usage, const MSAA msaa) {
+        const auto arraySize = getArraySize();
         const VkImageCreateFlags flags = arraySize == 6 ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        sampleCount = VKPhysicalDevice::vkSampleCountFlag[static_cast<int>(msaa)];
         const auto imageInfo = VkImageCreateInfo {
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .flags = flags,
             .imageType =  VK_IMAGE_TYPE_2D,
-            .format = vkFormats[static_cast<int>(format)],
-            .extent = {width, height, 1},
-            .mipLevels = mipLevels,
+            .format = vkFormats[static_cast<int>(getFormat())],
+            .extent = {getWidth(), getHeight(), 1},
+            .mipLevels = getMipLevels(),
             .arrayLayers = arraySize,
-            .samples = VKPhysicalDevice::vkSampleCountFlag[static_cast<int>(msaa)],
+            .samples = sampleCount,
             .tiling = VK_IMAGE_TILING_OPTIMAL,
             .usage = usage,
             .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
@@ -208,43 +361,21 @@ namespace vireo {
         vkCheck(vkCreateImage(device->getDevice(), &imageInfo, nullptr, &image));
 #ifdef _DEBUG
         vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(image), VK_OBJECT_TYPE_IMAGE,
-            "VKImage : " + name);
-#endif
-
-        VkMemoryRequirements memRequirements;
-        vkGetImageMemoryRequirements(device->getDevice(), image, &memRequirements);
-
-        const auto allocInfo = VkMemoryAllocateInfo {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = memRequirements.size,
-            .memoryTypeIndex = device->getPhysicalDevice().findMemoryType(
-                memRequirements.memoryTypeBits,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-        };
-        vkCheck(vkAllocateMemory(device->getDevice(), &allocInfo, nullptr, &imageMemory));
-        vkCheck(vkBindImageMemory(device->getDevice(), image, imageMemory, 0));
-        if constexpr (isMemoryUsageEnabled()) {
-            auto lock = std::lock_guard(memoryAllocationsMutex);
-            memoryAllocations.push_back({
-                VideoMemoryAllocationUsage::IMAGE,
-                name,
-                allocInfo.allocationSize,
-                image });
-        }
-#ifdef _DEBUG
-        vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(imageMemory), VK_OBJECT_TYPE_DEVICE_MEMORY,
-        "VKImage Memory : " + name);
+            "VKImage : " + getName());
 #endif
+    }
 
+    void VKImage::createImageView() {
+        const auto arraySize = getArraySize();
         const auto viewInfo = VkImageViewCreateInfo {
             .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
             .image = image,
             .viewType = arraySize == 6 ? VK_IMAGE_VIEW_TYPE_CUBE : arraySize > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
-            .format = vkFormats[static_cast<int>(format)],
+            .format = vkFormats[static_cast<int>(getFormat())],
             .subresourceRange = {
                 .aspectMask = static_cast<uint32_t>(aspect),
                 .baseMipLevel = 0,
-                .levelCount = mipLevels,
+                .levelCount = getMipLevels(),
                 .baseArrayLayer = 0,
                 .layerCount = VK_REMAINING_ARRAY_LAYERS
             }
@@ -252,20 +383,39 @@ namespace vireo {
         vkCheck(vkCreateImageView(device->getDevice(), &viewInfo, nullptr, &imageView));
 #ifdef _DEBUG
         vkSetObjectName(device->getDevice(), reinterpret_cast<uint64_t>(imageView), VK_OBJECT_TYPE_IMAGE_VIEW,
-            "VKImage view : " + name);
+            "VKImage view : " + getName());
 #endif
     }
 
+    VkMemoryRequirements VKImage::getMemoryRequirements() const {
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(device->getDevice(), image, &memRequirements);
+        return memRequirements;
+    }
+
+    void VKImage::bind(
+        const std::shared_ptr<const VKTransientMemory>& memory,
+        const VKTransientMemory::Placement& placement) {
+        assert(transientMemory == nullptr && allocation.block == nullptr);
+        transientMemory = memory;
+        vkCheck(vkBindImageMemory(device->getDevice(), image, placement.memory, placement.offset));
+        if constexpr (isMemoryUsageEnabled()) {
+            addMemoryAllocation({
+                VideoMemoryAllocationUsage::IMAGE,
+                getName(),
+                getMemoryRequirements().size,
+                image });
+        }
+        createImageView();
+    }
+
     VKImage::~VKImage() {
-        // if constexpr(isMemoryUsageEnabled()) {
-            // auto lock = std::lock_guard(memoryAllocationsMutex);
-            // memoryAllocations.remove_if([&](const VideoMemoryAllocationDesc& usage) {
-                // return usage.ref == image;
-            // });
-        // }
-        vkDestroyImage(device->getDevice(), image, nullptr);
-        vkFreeMemory(device->getDevice(), imageMemory, nullptr);
         vkDestroyImageView(device->getDevice(), imageView, nullptr);
+        vkDestroyImage(device->getDevice(), image, nullptr);
+        // Transient images memory is released with the last image of the set
+        if (allocation.block != nullptr) {
+            device->getMemoryAllocator().free(allocation);
+        }
     }
 
     ImageFormat VKImage::vkFormatToImageFormat(const VkFormat format) {
@@ -11,6 +11,7 @@ export module vireo.vulkan.resources;
 import std;
 import vireo;
 import vireo.vulkan.devices;
+import vireo.vulkan.memory;
 
 export namespace vireo {
 
@@ -31,18 +32,22 @@ export namespace vireo {
 
         inline auto getBuffer() const { return buffer; }
 
+        // Only available when the device uses descriptor buffers
+        auto getDeviceAddress() const { return deviceAddress; }
+
     private:
         const std::shared_ptr<const VKDevice> device;
-        VkBuffer       buffer{VK_NULL_HANDLE};
-        VkDeviceMemory bufferMemory{VK_NULL_HANDLE};
+        VkBuffer           buffer{VK_NULL_HANDLE};
+        VkDeviceAddress    deviceAddress{0};
+        VKMemoryAllocation allocation{};
 
         static void createBuffer(
             const std::shared_ptr<const VKDevice>& device,
             VkDeviceSize size,
             VkBufferUsageFlags usage,
-            uint32_t memoryTypeIndex,
+            VkMemoryPropertyFlags memoryProperties,
             VkBuffer& buffer,
-            VkDeviceMemory& memory);
+            VKMemoryAllocation& allocation);
     };
 
     class VKSampler : public Sampler {
@@ -69,6 +74,51 @@ export namespace vireo {
         VkSampler sampler;
     };
 
+    // Device memory shared by a set of transient render targets.
+    // Images are packed in slots with an interval graph colouring : images of the same slot have
+    // non-overlapping lifetimes and are aliased at the same offset.
+    class VKTransientMemory {
+    public:
+        struct Resource {
+            VkMemoryRequirements requirements;
+            uint32_t             firstUse;
+            uint32_t             lastUse;
+            // Attachment only images use lazily allocated memory when available and are never aliased
+            bool                 lazy;
+        };
+
+        struct Placement {
+            VkDeviceMemory memory;
+            VkDeviceSize   offset;
+        };
+
+        VKTransientMemory(const std::shared_ptr<const VKDevice>& device, const std::vector<Resource>& resources);
+
+        ~VKTransientMemory();
+
+        // Memory and offset of each resource, in the same order as the resources
+        const auto& getPlacements() const { return placements; }
+
+        VKTransientMemory(VKTransientMemory&) = delete;
+        VKTransientMemory& operator=(VKTransientMemory&) = delete;
+
+    private:
+        struct Slot {
+            uint32_t              memoryTypeBits;
+            VkDeviceSize          size{0};
+            VkDeviceSize          alignment{1};
+            VkDeviceSize          offset{0};
+            uint32_t              lastUse;
+            std::vector<uint32_t> resources;
+        };
+
+        const std::shared_ptr<const VKDevice> device;
+        std::vector<VKMemoryAllocation>       allocations;
+        std::vector<Placement>                placements;
+
+        bool hasLazyMemoryType(uint32_t typeFilter) const;
+    };
+
     class VKImage : public Image {
     public:
         static constexpr VkFormat vkFormats[] = {
@@ -165,8 +215,26 @@ export namespace vireo {
             bool isDepthBufferWithStencil,
             MSAA msaa);
 
+        // Transient render target, created without memory : bind() must be called before use
+        VKImage(
+            const std::shared_ptr<const VKDevice>& device,
+            ImageFormat format,
+            uint32_t    width,
+            uint32_t    height,
+            uint32_t    arraySize,
+            const std::string& name,
+            bool isDepthBuffer,
+            bool isDepthBufferWithStencil,
+            MSAA msaa,
+            bool transientAttachment);
+
         ~VKImage() override;
 
+        VkMemoryRequirements getMemoryRequirements() const;
+
+        // Binds a transient image on memory shared with other transient images
+        void bind(const std::shared_ptr<const VKTransientMemory>& memory, const VKTransientMemory::Placement& placement);
+
         auto getImage() const { return image; }
 
         auto getImageView() const { return imageView; }
@@ -175,14 +243,23 @@ export namespace vireo {
 
         auto getAspect() const { return aspect; }
 
+        auto getSampleCount() const { return sampleCount; }
+
         auto getDevice() const { return device; }
 
     private:
         const std::shared_ptr<const VKDevice> device;
         const int aspect;
         VkImage image{VK_NULL_HANDLE};
-        VkDeviceMemory imageMemory{VK_NULL_HANDLE};
+        VKMemoryAllocation allocation{};
         VkImageView imageView{VK_NULL_HANDLE};
+        VkSampleCountFlagBits sampleCount{VK_SAMPLE_COUNT_1_BIT};
+        // Memory of transient images, shared with the other images of the same set
+        std::shared_ptr<const VKTransientMemory> transientMemory;
+
+        void createImage(VkImageUsageFlags usage, MSAA msaa);
+
+        void createImageView();
     };
 
     class VKRenderTarget : public RenderTarget {
@@ -14,6 +14,7 @@ module;
 module vireo.vulkan.swapchains;
 
 import vireo.platform;
+import vireo.profiler;
 import vireo.tools;
 import vireo.vulkan.resources;
 import vireo.vulkan.tools;
@@ -54,6 +55,23 @@ namespace vireo {
         }
 #endif
 
+        createImageAvailableSemaphores();
+        create();
+    }
+
+    VKSwapChain::VKSwapChain(
+        const std::shared_ptr<const VKDevice>& device,
+        const std::shared_ptr<VKSubmitQueue>& presentQueue,
+        const ImageFormat format,
+        const uint32_t framesInFlight):
+        SwapChain{format, PresentMode::IMMEDIATE, framesInFlight},
+        device{device},
+        windowHandle{nullptr},
+        presentQueue{presentQueue} {
+        createImageAvailableSemaphores();
+    }
+
+    void VKSwapChain::createImageAvailableSemaphores() {
         imageIndex.resize(framesInFlight);
         imageAvailableSemaphore.resize(framesInFlight);
         imageAvailableSemaphoreInfo.resize(framesInFlight);
@@ -79,7 +97,6 @@ namespace vireo {
                 "VKSwapChain image available : " + std::to_string(i));
 #endif
         }
-        create();
     }
 
     void VKSwapChain::create() {
@@ -136,7 +153,10 @@ namespace vireo {
         vkGetSwapchainImagesKHR(device->getDevice(), swapChain, &imagesCount, swapChainImages.data());
         extent      = Extent{ swapChainExtent.width, swapChainExtent.height };
         aspectRatio = static_cast<float>(swapChainExtent.width) / static_cast<float>(swapChainExtent.height);
+        createImageViews();
+    }
 
+    void VKSwapChain::createImageViews() {
         renderFinishedSemaphore.resize(imagesCount);
         renderFinishedSemaphoreInfo.resize(imagesCount);
         constexpr auto semaphoreInfo = VkSemaphoreCreateInfo {
@@ -195,7 +215,9 @@ namespace vireo {
         }
     }
     void VKSwapChain::cleanupSwapChain(const VkSwapchainKHR oldSwapChain) const {
-        vkDestroySwapchainKHR(device->getDevice(), oldSwapChain, nullptr);
+        if (oldSwapChain != VK_NULL_HANDLE) {
+            vkDestroySwapchainKHR(device->getDevice(), oldSwapChain, nullptr);
+        }
     }
 
     void VKSwapChain::cleanup() {
@@ -295,6 +317,7 @@ namespace vireo {
     }
 
     void VKSwapChain::present() {
+        const auto zone = CPUProfiler::Zone{"VKSwapChain::present"};
         const VkSwapchainKHR   swapChains[] = { swapChain };
         const auto presentInfo = VkPresentInfoKHR {
             .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
@@ -306,6 +329,8 @@ namespace vireo {
             .pResults           = nullptr // Optional
         };
         auto lock = std::lock_guard{presentQueue->getMutex()};
+        // The render finished semaphore may be signaled by a deferred submission
+        presentQueue->flush();
         const auto result = vkQueuePresentKHR(presentQueue->getCommandQueue(), &presentInfo);
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
             recreate();
@@ -316,6 +341,7 @@ namespace vireo {
     }
 
     bool VKSwapChain::acquire(const std::shared_ptr<Fence>& fence) {
+        const auto zone = CPUProfiler::Zone{"VKSwapChain::acquire"};
         assert(fence != nullptr);
         const auto vkFence = static_pointer_cast<VKFence>(fence);
         // wait until the GPU has finished rendering the frame.
@@ -346,7 +372,191 @@ namespace vireo {
         for (int i = 0; i < framesInFlight; i++) {
             vkDestroySemaphore(device->getDevice(), imageAvailableSemaphore[i], nullptr);
         }
-        vkDestroySurfaceKHR(device->getPhysicalDevice().getInstance(), surface, nullptr);
+        if (surface != VK_NULL_HANDLE) {
+            vkDestroySurfaceKHR(device->getPhysicalDevice().getInstance(), surface, nullptr);
+        }
+    }
+
+    VKOffscreenSwapChain::VKOffscreenSwapChain(
+        const std::shared_ptr<const VKDevice>& device,
+        const std::shared_ptr<VKSubmitQueue>& presentQueue,
+        const Extent& extent,
+        const ImageFormat format,
+        const uint32_t framesInFlight):
+        VKSwapChain{device, presentQueue, format, framesInFlight} {
+        assert(extent.width > 0 && extent.height > 0);
+        this->extent = extent;
+        aspectRatio = static_cast<float>(extent.width) / static_cast<float>(extent.height);
+        swapChainExtent = { extent.width, extent.height };
+        swapChainImageFormat = VKImage::vkFormats[static_cast<int>(format)];
+        imagesCount = framesInFlight;
+        swapChainImages.resize(imagesCount);
+        swapChainImageViews.resize(imagesCount);
+        images.resize(imagesCount);
+        readbackBuffers.resize(imagesCount);
+        const auto rowSize = extent.width * Image::pixelSize[static_cast<int>(format)];
+        for (uint32_t i = 0; i < imagesCount; i++) {
+            images[i] = std::make_shared<VKImage>(
+                device,
+                format,
+                extent.width,
+                extent.height,
+                1,
+                1,
+                "VKOffscreenSwapChain Image " + std::to_string(i),
+                false,
+                true,
+                false,
+                false,
+                MSAA::NONE);
+            swapChainImages[i] = images[i]->getImage();
+            imageIndex[i] = i;
+            readbackBuffers[i] = std::make_shared<VKBuffer>(
+                device,
+                BufferType::BUFFER_DOWNLOAD,
+                rowSize,
+                extent.height,
+                "VKOffscreenSwapChain readback " + std::to_string(i));
+            readbackBuffers[i]->map();
+        }
+        createImageViews();
+
+        const auto poolInfo = VkCommandPoolCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .queueFamilyIndex = device->getGraphicsQueueFamilyIndex()
+        };
+        vkCheck(vkCreateCommandPool(device->getDevice(), &poolInfo, nullptr, &commandPool));
+        copyCommandBuffers.resize(imagesCount);
+        const auto allocInfo = VkCommandBufferAllocateInfo {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = commandPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = imagesCount,
+        };
+        vkCheck(vkAllocateCommandBuffers(device->getDevice(), &allocInfo, copyCommandBuffers.data()));
+        copyFences.resize(imagesCount);
+        constexpr auto fenceInfo = VkFenceCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+            .flags = VK_FENCE_CREATE_SIGNALED_BIT
+        };
+        constexpr auto beginInfo = VkCommandBufferBeginInfo {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        };
+        // The frame buffers are presented in the copy source layout, the copies are recorded once
+        const auto copyRegion = VkBufferImageCopy {
+            .bufferOffset = 0,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = 0,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+            .imageOffset = {0, 0, 0},
+            .imageExtent = {extent.width, extent.height, 1},
+        };
+        constexpr auto hostBarrier = VkMemoryBarrier {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+        };
+        for (uint32_t i = 0; i < imagesCount; i++) {
+            vkCheck(vkCreateFence(device->getDevice(), &fenceInfo, nullptr, &copyFences[i]));
+            vkCheck(vkBeginCommandBuffer(copyCommandBuffers[i], &beginInfo));
+            vkCmdCopyImageToBuffer(
+                copyCommandBuffers[i],
+                swapChainImages[i],
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                readbackBuffers[i]->getBuffer(),
+                1,
+                &copyRegion);
+            vkCmdPipelineBarrier(
+                copyCommandBuffers[i],
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_HOST_BIT,
+                0,
+                1, &hostBarrier,
+                0, nullptr,
+                0, nullptr);
+            vkCheck(vkEndCommandBuffer(copyCommandBuffers[i]));
+        }
+
+        // The first acquire of each frame buffer waits for an image available semaphore, as the next ones
+        auto signals = std::vector<VkSemaphoreSubmitInfo>(framesInFlight);
+        for (int i = 0; i < framesInFlight; i++) {
+            signals[i] = imageAvailableSemaphoreInfo[i];
+            signals[i].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        }
+        const auto submitInfo = VkSubmitInfo2 {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .signalSemaphoreInfoCount = static_cast<uint32_t>(signals.size()),
+            .pSignalSemaphoreInfos = signals.data(),
+        };
+        auto lock = std::lock_guard{presentQueue->getMutex()};
+        vkCheck(vkQueueSubmit2(presentQueue->getCommandQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+    }
+
+    bool VKOffscreenSwapChain::acquire(const std::shared_ptr<Fence>& fence) {
+        const auto zone = CPUProfiler::Zone{"VKOffscreenSwapChain::acquire"};
+        assert(fence != nullptr);
+        const auto vkFence = static_pointer_cast<VKFence>(fence);
+        // Waits until the GPU has finished rendering the frame and copying the frame buffer
+        const VkFence fences[] = { vkFence->getFence(), copyFences[currentFrameIndex] };
+        if (vkWaitForFences(device->getDevice(), 2, fences, VK_TRUE, UINT64_MAX) == VK_TIMEOUT) {
+            throw Exception("timeout waiting for inFlightFence");
+        }
+        vkResetFences(device->getDevice(), 1, &vkFence->getFence());
+        return true;
+    }
+
+    void VKOffscreenSwapChain::present() {
+        const auto zone = CPUProfiler::Zone{"VKOffscreenSwapChain::present"};
+        // The copy waits for the rendering and releases the frame buffer for the next acquire
+        auto wait = getCurrentRenderFinishedSemaphoreInfo();
+        wait.stageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        auto signal = imageAvailableSemaphoreInfo[currentFrameIndex];
+        signal.stageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        const auto commandBufferInfo = VkCommandBufferSubmitInfo {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+            .commandBuffer = copyCommandBuffers[currentFrameIndex],
+        };
+        const auto submitInfo = VkSubmitInfo2 {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .waitSemaphoreInfoCount = 1,
+            .pWaitSemaphoreInfos = &wait,
+            .commandBufferInfoCount = 1,
+            .pCommandBufferInfos = &commandBufferInfo,
+            .signalSemaphoreInfoCount = 1,
+            .pSignalSemaphoreInfos = &signal,
+        };
+        vkResetFences(device->getDevice(), 1, &copyFences[currentFrameIndex]);
+        auto lock = std::lock_guard{presentQueue->getMutex()};
+        // The render finished semaphore may be signaled by a deferred submission
+        presentQueue->flush();
+        vkCheck(vkQueueSubmit2(presentQueue->getCommandQueue(), 1, &submitInfo, copyFences[currentFrameIndex]));
+        lastPresentedFrame = currentFrameIndex;
+    }
+
+    const void* VKOffscreenSwapChain::readback() const {
+        if (lastPresentedFrame == NO_FRAME) {
+            return nullptr;
+        }
+        if (vkWaitForFences(device->getDevice(), 1, &copyFences[lastPresentedFrame], VK_TRUE, UINT64_MAX) == VK_TIMEOUT) {
+            throw Exception("timeout waiting for the frame buffer copy");
+        }
+        return readbackBuffers[lastPresentedFrame]->getMappedAddress();
+    }
+
+    VKOffscreenSwapChain::~VKOffscreenSwapChain() {
+        waitIdle();
+        for (const auto fence : copyFences) {
+            vkDestroyFence(device->getDevice(), fence, nullptr);
+        }
+        vkDestroyCommandPool(device->getDevice(), commandPool, nullptr);
+        for (const auto& buffer : readbackBuffers) {
+            buffer->unmap();
+        }
     }
 
-}
\ No newline at end of file
+}
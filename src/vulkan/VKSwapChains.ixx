@@ -13,6 +13,7 @@ import vireo;
 import vireo.platform;
 import vireo.vulkan.commands;
 import vireo.vulkan.devices;
+import vireo.vulkan.resources;
 
 export namespace vireo {
 
@@ -34,6 +35,8 @@ export namespace vireo {
 
         auto getCurrentImageView() const { return swapChainImageViews[imageIndex[currentFrameIndex]]; }
 
+        auto getImageFormat() const { return swapChainImageFormat; }
+
         void nextFrameIndex() override;
 
         bool acquire(const std::shared_ptr<Fence>& fence) override;
@@ -48,7 +51,22 @@ export namespace vireo {
 
         void waitIdle() override { vkDeviceWaitIdle(device->getDevice()); }
 
-    private:
+        // Offscreen swap chains have no surface
+        auto isOffscreen() const { return surface == VK_NULL_HANDLE; }
+
+        // The frame buffers of offscreen swap chains are presented in the copy source layout
+        ResourceState getImageState(const ResourceState state) const {
+            return isOffscreen() && state == ResourceState::PRESENT ? ResourceState::COPY_SRC : state;
+        }
+
+    protected:
+        // Offscreen swap chain, the frame buffers are created by the derived class
+        VKSwapChain(
+            const std::shared_ptr<const VKDevice>& device,
+            const std::shared_ptr<VKSubmitQueue>& presentQueue,
+            ImageFormat format,
+            uint32_t framesInFlight);
+
         static constexpr VkPresentModeKHR vkPresentModes[] {
             VK_PRESENT_MODE_IMMEDIATE_KHR,
             VK_PRESENT_MODE_FIFO_KHR
@@ -64,7 +82,7 @@ export namespace vireo {
         // Platform specific window handle
         PlatformWindowHandle windowHandle;
         // Rendering window drawing surface
-        VkSurfaceKHR surface;
+        VkSurfaceKHR surface{VK_NULL_HANDLE};
         VkSwapchainKHR swapChain{VK_NULL_HANDLE};
         uint32_t imagesCount;
         // Frame buffers
@@ -92,6 +110,11 @@ export namespace vireo {
 
         void create();
 
+        void createImageAvailableSemaphores();
+
+        // Creates the images views and the render finished semaphores of the frame buffers
+        void createImageViews();
+
         void cleanup();
 
         void cleanupImages() const;
@@ -111,4 +134,39 @@ export namespace vireo {
         VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities) const;
     };
 
-}
\ No newline at end of file
+    // Swap chain without window, backed by a ring of render targets copied in host memory when presented
+    class VKOffscreenSwapChain : public VKSwapChain {
+    public:
+        VKOffscreenSwapChain(
+            const std::shared_ptr<const VKDevice>& device,
+            const std::shared_ptr<VKSubmitQueue>& presentQueue,
+            const Extent& extent,
+            ImageFormat format,
+            uint32_t framesInFlight);
+
+        ~VKOffscreenSwapChain() override;
+
+        bool acquire(const std::shared_ptr<Fence>& fence) override;
+
+        void present() override;
+
+        // The extent of an offscreen swap chain never changes
+        void recreate() override {}
+
+        const void* readback() const override;
+
+    private:
+        static constexpr auto NO_FRAME{std::numeric_limits<uint32_t>::max()};
+
+        std::vector<std::shared_ptr<VKImage>>  images;
+        // Host visible copies of the frame buffers
+        std::vector<std::shared_ptr<VKBuffer>> readbackBuffers;
+        VkCommandPool                          commandPool{VK_NULL_HANDLE};
+        // Pre-recorded copies of the frame buffers into the readback buffers
+        std::vector<VkCommandBuffer>           copyCommandBuffers;
+        // Signaled when the copy of a frame buffer is completed
+        std::vector<VkFence>                   copyFences;
+        uint32_t                               lastPresentedFrame{NO_FRAME};
+    };
+
+}
@@ -15,18 +15,29 @@ import vireo.vulkan.tools;
 
 namespace vireo {
 
-    VKVireo::VKVireo(const BackendConfiguration& config) {
+    VKVireo::VKVireo(const BackendConfiguration& config) :
+        headless{config.headless} {
         instance = std::make_shared<VKInstance>(config);
-        physicalDevice = std::make_shared<VKPhysicalDevice>(getVKInstance()->getInstance());
+        physicalDevice = std::make_shared<VKPhysicalDevice>(
+            getVKInstance()->getInstance(),
+            config.vulkanDescriptorBuffer,
+            config.headless);
         device = std::make_shared<VKDevice>(*getVKPhysicalDevice(), getVKInstance()->getRequestedLayers());
     }
 
+    VKVireo::~VKVireo() {
+        stopCompilationThreads();
+    }
+
     std::shared_ptr<SwapChain> VKVireo::createSwapChain(
         const ImageFormat format,
         const std::shared_ptr<SubmitQueue>& submitQueue,
         PlatformWindowHandle windowHandle,
         const PresentMode presentMode,
         const uint32_t framesInFlight) const {
+        if (headless) {
+            throw Exception("Window swap chains are not available in headless mode, use createOffscreenSwapChain()");
+        }
         return std::make_shared<VKSwapChain>(getVKDevice(),
             static_pointer_cast<VKSubmitQueue>(submitQueue),
             windowHandle,
@@ -35,6 +46,18 @@ namespace vireo {
             framesInFlight);
     }
 
+    std::shared_ptr<SwapChain> VKVireo::createOffscreenSwapChain(
+        const ImageFormat format,
+        const std::shared_ptr<SubmitQueue>& presentQueue,
+        const Extent& extent,
+        const uint32_t framesInFlight) const {
+        return std::make_shared<VKOffscreenSwapChain>(getVKDevice(),
+            static_pointer_cast<VKSubmitQueue>(presentQueue),
+            extent,
+            format,
+            framesInFlight);
+    }
+
     std::shared_ptr<SubmitQueue> VKVireo::createSubmitQueue(
             CommandType commandType,
             const std::string& name) const {
@@ -75,6 +98,11 @@ namespace vireo {
         return std::make_shared<VKShaderModule>(getVKDevice()->getDevice(), data, name);
     }
 
+    std::shared_ptr<ShaderModule> VKVireo::createShaderModule(
+        const std::span<const uint32_t> code, const std::string& name) const {
+        return std::make_shared<VKShaderModule>(getVKDevice()->getDevice(), code, name);
+    }
+
     std::shared_ptr<PipelineResources> VKVireo::createPipelineResources(
         const std::vector<std::shared_ptr<DescriptorLayout>>& descriptorLayouts,
         const PushConstantsDesc& pushConstant,
@@ -86,7 +114,13 @@ namespace vireo {
         const std::shared_ptr<PipelineResources>& pipelineResources,
         const std::shared_ptr<const ShaderModule>& shader,
         const std::string& name) const {
-        return std::make_shared<VKComputePipeline>(getVKDevice()->getDevice(), pipelineResources, shader, name);
+        return std::make_shared<VKComputePipeline>(
+            getVKDevice()->getDevice(),
+            getVKDevice()->getPipelineCache(),
+            getVKDevice()->getPipelineCreateFlags(),
+            pipelineResources,
+            shader,
+            name);
     }
 
     std::shared_ptr<GraphicPipeline> VKVireo::createGraphicPipeline(
@@ -209,28 +243,75 @@ namespace vireo {
            image);
     }
 
+    std::vector<std::shared_ptr<RenderTarget>> VKVireo::createTransientRenderTargets(
+        const std::vector<TransientRenderTargetDesc>& descs) const {
+        auto images = std::vector<std::shared_ptr<VKImage>>{};
+        auto resources = std::vector<VKTransientMemory::Resource>{};
+        for (const auto& desc : descs) {
+            const auto& image = images.emplace_back(std::make_shared<VKImage>(
+                getVKDevice(),
+                desc.format,
+                desc.width,
+                desc.height,
+                desc.arraySize,
+                desc.name,
+                desc.type == RenderTargetType::DEPTH || desc.type == RenderTargetType::DEPTH_STENCIL,
+                desc.type == RenderTargetType::DEPTH_STENCIL,
+                desc.msaa,
+                desc.attachmentOnly));
+            resources.push_back({
+                image->getMemoryRequirements(),
+                desc.firstUse,
+                desc.lastUse,
+                desc.attachmentOnly });
+        }
+        const auto memory = std::make_shared<VKTransientMemory>(getVKDevice(), resources);
+        auto renderTargets = std::vector<std::shared_ptr<RenderTarget>>{};
+        for (int i = 0; i < descs.size(); i++) {
+            images[i]->bind(memory, memory->getPlacements()[i]);
+            renderTargets.push_back(std::make_shared<VKRenderTarget>(descs[i].type, images[i]));
+        }
+        return renderTargets;
+    }
+
     void VKVireo::waitIdle() {
         vkDeviceWaitIdle(getVKDevice()->getDevice());
     }
 
     std::shared_ptr<DescriptorLayout> VKVireo::createBindlessDescriptorLayout(
         const std::string& name) const {
-        return std::make_shared<VKDescriptorLayout>(getVKDevice()->getDevice(), false, false, true, name);
+        return std::make_shared<VKDescriptorLayout>(
+            getVKDevice()->getDevice(),
+            getVKDevice()->getDescriptorHeap(),
+            false, false, true,
+            name);
     }
 
     std::shared_ptr<DescriptorLayout> VKVireo::createDescriptorLayout(
         const std::string& name) const {
-        return std::make_shared<VKDescriptorLayout>(getVKDevice()->getDevice(), false, false, false, name);
+        return std::make_shared<VKDescriptorLayout>(
+            getVKDevice()->getDevice(),
+            getVKDevice()->getDescriptorHeap(),
+            false, false, false,
+            name);
     }
 
     std::shared_ptr<DescriptorLayout> VKVireo::createSamplerDescriptorLayout(
         const std::string& name) const {
-        return std::make_shared<VKDescriptorLayout>(getVKDevice()->getDevice(), true, false, false, name);
+        return std::make_shared<VKDescriptorLayout>(
+            getVKDevice()->getDevice(),
+            getVKDevice()->getDescriptorHeap(),
+            true, false, false,
+            name);
     }
 
     std::shared_ptr<DescriptorLayout> VKVireo::_createDynamicUniformDescriptorLayout(
         const std::string& name) const {
-        return std::make_shared<VKDescriptorLayout>(getVKDevice()->getDevice(), false, true, false, name);
+        return std::make_shared<VKDescriptorLayout>(
+            getVKDevice()->getDevice(),
+            getVKDevice()->getDescriptorHeap(),
+            false, true, false,
+            name);
     }
 
     std::shared_ptr<DescriptorSet> VKVireo::createDescriptorSet(
@@ -239,6 +320,14 @@ namespace vireo {
         return std::make_shared<VKDescriptorSet>(layout, name);
     }
 
+    std::shared_ptr<TransientDescriptorAllocator> VKVireo::createTransientDescriptorAllocator(
+            const std::string& name) const {
+        return std::make_shared<VKTransientDescriptorAllocator>(
+            getVKDevice()->getDevice(),
+            getVKDevice()->getDescriptorHeap(),
+            name);
+    }
+
     std::shared_ptr<Sampler> VKVireo::createSampler(
            Filter minFilter,
            Filter magFilter,
@@ -20,6 +20,8 @@ export namespace vireo {
     public:
         VKVireo(const BackendConfiguration& config);
 
+        ~VKVireo() override;
+
         void waitIdle() override;
 
         std::shared_ptr<SwapChain> createSwapChain(
@@ -29,6 +31,12 @@ export namespace vireo {
             PresentMode presentMode,
             uint32_t framesInFlight) const override;
 
+        std::shared_ptr<SwapChain> createOffscreenSwapChain(
+            ImageFormat format,
+            const std::shared_ptr<SubmitQueue>& presentQueue,
+            const Extent& extent,
+            uint32_t framesInFlight) const override;
+
         std::shared_ptr<SubmitQueue> createSubmitQueue(
             CommandType commandType,
             const std::string& name) const override;
@@ -57,6 +65,10 @@ export namespace vireo {
             const std::vector<char>& data,
             const std::string& name) const override;
 
+        std::shared_ptr<ShaderModule> createShaderModule(
+            std::span<const uint32_t> code,
+            const std::string& name) const override;
+
 
         std::shared_ptr<PipelineResources> createPipelineResources(
             const std::vector<std::shared_ptr<DescriptorLayout>>& descriptorLayouts,
@@ -113,6 +125,9 @@ export namespace vireo {
         std::shared_ptr<RenderTarget> createRenderTarget(
             const std::shared_ptr<Image>& image) const override;
 
+        std::vector<std::shared_ptr<RenderTarget>> createTransientRenderTargets(
+            const std::vector<TransientRenderTargetDesc>& descs) const override;
+
         std::shared_ptr<DescriptorLayout> createBindlessDescriptorLayout(
             const std::string& name) const override;
 
@@ -129,6 +144,9 @@ export namespace vireo {
             const std::shared_ptr<const DescriptorLayout>& layout,
             const std::string& name) const override;
 
+        std::shared_ptr<TransientDescriptorAllocator> createTransientDescriptorAllocator(
+            const std::string& name) const override;
+
         std::shared_ptr<Sampler> createSampler(
             Filter minFilter,
             Filter magFilter,
@@ -153,11 +171,27 @@ export namespace vireo {
             return Backend::VULKAN;
         }
 
+        bool loadPipelineCache(const std::string& fileName) override {
+            return getVKDevice()->loadPipelineCache(fileName);
+        }
+
+        void savePipelineCache(const std::string& fileName) const override {
+            getVKDevice()->savePipelineCache(fileName);
+        }
+
+        MemoryStatistics getMemoryStatistics() const override {
+            return getVKDevice()->getMemoryAllocator().getStatistics();
+        }
+
         auto getVKInstance() const { return reinterpret_pointer_cast<VKInstance>(instance); }
 
         auto getVKPhysicalDevice() const { return reinterpret_pointer_cast<VKPhysicalDevice>(physicalDevice); }
 
         auto getVKDevice() const { return reinterpret_pointer_cast<VKDevice>(device); }
+
+    private:
+        // No surface and swap chain extensions
+        const bool headless;
     };
 
 }
\ No newline at end of file